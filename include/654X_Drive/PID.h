@@ -34,8 +34,12 @@ public:
      * @param settle_error Maximum error to be considered settled.
      * @param settle_time Minimum time to be considered settled.
      * @param timeout Time after which to give up and move on. Using 0 will not time out movement.
+     * @param settle_velocity Rate of change of error, per second, below which the movement may settle
+     * before settle_time has passed. Using 0 always waits out settle_time.
+     * @param settle_confirm_time Time error must be less than settle_error while changing slower than
+     * settle_velocity to settle early.
      */
-    PID(float error, float kp, float ki, float kd, float starti, float settle_error, float settle_time, float timeout);
+    PID(float error, float kp, float ki, float kd, float starti, float settle_error, float settle_time, float timeout, float settle_velocity = 0, float settle_confirm_time = 0);
 
     /**
      * @brief Computes the output power based on the error.
@@ -48,16 +52,42 @@ public:
      */
     float compute(float error);
 
+    /**
+     * @brief Computes the output power based on the error and the measured loop time.
+     * The I and D terms are scaled by dt relative to nominal_dt, so gains tuned
+     * on a 10 ms loop behave the same when the loop runs early or late. Settle
+     * time and timeout accumulate the real elapsed time.
+     * 
+     * @param error Difference in desired and current position.
+     * @param dt Time since the last call in milliseconds. Values <= 0 fall back to nominal_dt.
+     * @return Output power.
+     */
+    float compute(float error, float dt);
+
     /**
      * @brief Computes whether or not the movement has settled.
      * The robot is considered settled when error is less than settle_error 
      * for a duration of settle_time, or if the function has gone on for 
-     * longer than timeout. Otherwise it is not settled.
+     * longer than timeout. With settle_velocity set, it is also settled once
+     * error is less than settle_error and barely changing for settle_confirm_time,
+     * since a robot already stopped at the target won't get any closer by waiting.
+     * Otherwise it is not settled.
      * 
      * @return Whether the movement is settled.
      */
     bool is_settled();
 
+    /**
+     * @brief How much of settle_time an early settle didn't wait out, for the settle report.
+     * Read once is_settled() has returned true.
+     * 
+     * @return Milliseconds, 0 unless the movement settled early.
+     */
+    float get_time_saved() const;
+
+    /** @return Whether the movement ran past its timeout. */
+    bool is_timed_out() const;
+
     float error = 0;
     float kp = 0;
     float ki = 0;
@@ -69,9 +99,13 @@ public:
     float settle_error = 0;
     float settle_time = 0;
     float timeout = 0;
+    float settle_velocity = 0;
+    float settle_confirm_time = 0;
     float accumulated_error = 0;
     float previous_error = 0;
     float output = 0;
     float time_spent_settled = 0;
     float time_spent_running = 0;
+    float time_spent_still = 0; // Time error has been settled and changing slower than settle_velocity.
+    float nominal_dt = 10; // Loop period in milliseconds the gains were tuned at.
 };
\ No newline at end of file
@@ -3,6 +3,15 @@
 #include "vex.h"
 
 enum class color_sort { RED, BLUE, NONE };
+/** @brief Assembly sensor readings captured once per loop iteration, so each iteration sees one consistent set. */
+struct assembly_frame {
+    uint32_t timestamp = 0; // vex::timer::system() in milliseconds when the frame was captured.
+    float LB_angle = 0; // Lady brown encoder angle in degrees (0-360).
+    float intake_position = 0; // Intake motor position in degrees.
+    float ring_hue = 0; // Ring color sensor hue in degrees.
+    float ring_distance = 0; // Ring distance sensor reading in millimeters.
+};
+
 enum LB_state : int { ACTIVE = 206, INACTIVE = 229, HOLDING = 170, SCORING = 43, HANG = 345, DESCORE_TOP = 79, DECSCORE_BOTTOM = 65 };
 
 class Assembly {
@@ -20,6 +29,9 @@ public:
         int list_piston_port
     );
     
+    /** @return Every assembly sensor read once, loops capture one per iteration and read from it. */
+    assembly_frame capture_frame();
+
     void init_LB();
     void initialize_user_control();
     void stop_motors(vex::brakeType brake);
@@ -12,6 +12,44 @@ enum class drive_mode {
     TANK_CURVED,          // Tank drive with curved turn (from lemlib)
 };
 
+/** @brief Selects which pose estimate the odom task publishes. */
+enum class odom_mode {
+    ARC,  // Tracking wheel arc odometry, trusts the trackers and inertial completely.
+    EKF,  // Kalman filter fusing the trackers, drive encoders and inertial.
+};
+
+/** @brief One finished motion in the early settle report. */
+struct settle_report_entry {
+    uint32_t duration = 0; // How long the motion ran, in milliseconds.
+    float time_saved = 0; // Settle time early settling didn't wait out, in milliseconds.
+    float time_settled = 0; // How long the error had been within settle_error when the motion ended, in milliseconds.
+    bool timed_out = false; // Ended on its timeout rather than settling.
+};
+
+/** @brief Timing of one queued motion, in milliseconds from vex::timer::system(). */
+struct motion_segment_timing {
+    std::string name;
+    uint32_t queued_time = 0; // When the segment was queued.
+    uint32_t start_time = 0; // When it took over, 0 until then.
+    uint32_t end_time = 0; // When it finished, 0 until then.
+};
+
+/** @brief An action fired from the control loop the first tick its condition holds during a motion. */
+struct motion_trigger {
+    std::function<bool(float)> condition; // Given the time since the motion started in milliseconds.
+    std::function<void()> action;
+};
+
+/** @brief Where a motion is trying to end up, in field coordinates after mirroring. */
+struct motion_target {
+    const char* name = ""; // The function that started the motion.
+    bool has_position = false; // False for turns and swings, which only aim for a heading.
+    float X_position = 0;
+    float Y_position = 0;
+    bool has_heading = false; // False for motions that end facing wherever the approach left them.
+    float heading = 0;
+};
+
 constexpr direction clockwise = direction::CW;
 constexpr direction counter_clockwise = direction::CCW;
 constexpr direction cw = direction::CW;
@@ -25,6 +63,7 @@ struct drive_to_pose_params;
 struct turn_to_point_params;
 struct swing_to_point_params;
 struct follow_path_params;
+struct follow_trajectory_params;
 
 class Chassis {
 public:
@@ -41,6 +80,8 @@ public:
     float drive_settle_error; // Error to be considered settled in degrees.
     float drive_settle_time; // Time to be considered settled in milliseconds.
     float drive_timeout; // Time before quitting and move on in milliseconds.
+    float drive_settle_velocity = 0; // Error change in inches per second below which a motion may settle early, 0 to always wait out settle_time.
+    float drive_settle_confirm_time = 30; // Time a motion must be within settle error and slower than settle velocity to settle early, in milliseconds.
 
     float heading_max_voltage; // Max voltage out of 12.
     float heading_kp; // Proportional constant.
@@ -59,6 +100,8 @@ public:
     float turn_settle_error; // Error to be considered settled in degrees.
     float turn_settle_time; // Time to be considered settled in milliseconds.
     float turn_timeout; // Time before quitting and move on in milliseconds.
+    float turn_settle_velocity = 0; // Error change in degrees per second below which a motion may settle early, 0 to always wait out settle_time.
+    float turn_settle_confirm_time = 30; // Time a motion must be within settle error and slower than settle velocity to settle early, in milliseconds.
 
     float swing_min_voltage = 0; // Minimum voltage for swinging out of 12.
     float swing_max_voltage; // Max voltage out of 12.
@@ -71,11 +114,35 @@ public:
     float swing_settle_error; // Error to be considered settled in degrees.
     float swing_settle_time; // Time to be considered settled in milliseconds.
     float swing_timeout; // Time before quitting and move on in milliseconds.
+    float swing_settle_velocity = 0; // Error change in degrees per second below which a motion may settle early, 0 to always wait out settle_time.
+    float swing_settle_confirm_time = 30; // Time a motion must be within settle error and slower than settle velocity to settle early, in milliseconds.
     
     float boomerang_lead; // Constant scale factor that determines how far away the carrot point is. 
     float boomerang_setback; // Distance in inches from target by which the carrot is always pushed back.
 
     float pursuit_lookahead_distance;
+    float pursuit_max_lateral_acceleration = 80; // Profiled follow_path max acceleration towards the center of a curve in inches per second squared.
+
+    float drive_track_width = 12; // Distance between the left and right wheels in inches.
+    float ramsete_b = .0013; // RAMSETE aggressiveness in 1/inches squared, the usual 2 in meters.
+    float ramsete_zeta = .7; // RAMSETE damping between 0 and 1.
+
+    float drive_max_velocity = 60; // Profiled drive max velocity in inches per second.
+    float drive_max_acceleration = 120; // Profiled drive max acceleration in inches per second squared.
+    float drive_max_jerk = 0; // Profiled drive max jerk in inches per second cubed, 0 for trapezoidal.
+
+    float drive_slew_accelerate = 0; // Largest increase in each side's drive voltage per second, 0 for no limit.
+    float drive_slew_decelerate = 0; // Largest decrease in each side's drive voltage per second, 0 for no limit.
+
+    float turn_max_velocity = 450; // Profiled turn max velocity in degrees per second.
+    float turn_max_acceleration = 1500; // Profiled turn max acceleration in degrees per second squared.
+    float turn_max_jerk = 0; // Profiled turn max jerk in degrees per second cubed, 0 for trapezoidal.
+
+    feedforward drive_feedforward = feedforward(0, .17, .02); // Volts for each side from inches per second of wheel speed.
+    feedforward turn_feedforward = feedforward(0, .02, .002); // Volts for each side from degrees per second of turning.
+
+    float drive_wheel_diameter = 3.25; // Drive wheel diameter in inches.
+    float drive_gear_ratio = .75; // Wheel rotations per motor rotation.
 
     float control_throttle_deadband; // Deadband percent for the throttle axis.
     float control_throttle_min_output; // Minimum throttle output percent after deadband.
@@ -94,6 +161,7 @@ public:
     float desired_Y_position = 0;
     float desired_angle_offset = 0;
     std::vector<point> desired_path{};
+    motion_target desired_target{}; // Where the running motion, or the last one, was trying to end up.
 
     /**
      * @param left_drive  Motor group on the robot's left side.
@@ -182,6 +250,16 @@ public:
      */
     void set_turn_exit_conditions(float turn_settle_error, float turn_settle_time, float turn_timeout);
 
+    /**
+     * @brief Resets default turn early settle conditions.
+     * The robot also exits once error is less than settle_error and changing slower than
+     * settle_velocity for settle_confirm_time, instead of waiting out all of settle_time.
+     * 
+     * @param turn_settle_velocity Error change in degrees per second below which the robot counts as stopped. 0 turns early settling off.
+     * @param turn_settle_confirm_time Time to be stopped within settle error before exiting, in milliseconds.
+     */
+    void set_turn_early_settle_conditions(float turn_settle_velocity, float turn_settle_confirm_time);
+
     /**
      * @brief Resets default drive exit conditions.
      * The robot exits when error is less than settle_error for a duration of settle_time, 
@@ -193,6 +271,16 @@ public:
      */
     void set_drive_exit_conditions(float drive_settle_error, float drive_settle_time, float drive_timeout);
 
+    /**
+     * @brief Resets default drive early settle conditions.
+     * The robot also exits once error is less than settle_error and changing slower than
+     * settle_velocity for settle_confirm_time, instead of waiting out all of settle_time.
+     * 
+     * @param drive_settle_velocity Error change in inches per second below which the robot counts as stopped. 0 turns early settling off.
+     * @param drive_settle_confirm_time Time to be stopped within settle error before exiting, in milliseconds.
+     */
+    void set_drive_early_settle_conditions(float drive_settle_velocity, float drive_settle_confirm_time);
+
     /**
      * @brief Resets default swing exit conditions.
      * The robot exits when error is less than settle_error for a duration of settle_time, 
@@ -204,13 +292,86 @@ public:
      */
     void set_swing_exit_conditions(float swing_settle_error, float swing_settle_time, float swing_timeout);
 
+    /**
+     * @brief Resets default swing early settle conditions.
+     * The robot also exits once error is less than settle_error and changing slower than
+     * settle_velocity for settle_confirm_time, instead of waiting out all of settle_time.
+     * 
+     * @param swing_settle_velocity Error change in degrees per second below which the robot counts as stopped. 0 turns early settling off.
+     * @param swing_settle_confirm_time Time to be stopped within settle error before exiting, in milliseconds.
+     */
+    void set_swing_early_settle_conditions(float swing_settle_velocity, float swing_settle_confirm_time);
+
+    /**
+     * @brief Resets default drive slew constants.
+     * Limits how fast each side's voltage can change in drive_distance(), turn_to_angle(),
+     * turn_to_point(), drive_to_point(), drive_to_pose() and follow_path(), so motions
+     * don't jump to max voltage on the first tick and break traction.
+     * 
+     * @param drive_slew_accelerate Largest increase in volts per second, 0 for no limit.
+     * @param drive_slew_decelerate Largest decrease in volts per second, 0 for no limit.
+     */
+    void set_drive_slew_constants(float drive_slew_accelerate, float drive_slew_decelerate);
+
+    /**
+     * @brief Resets default drive motion profile constants.
+     * Used by drive_distance() when profiled is set. The profile setpoint is tracked
+     * with the drive feedforward plus the drive PID.
+     * 
+     * @param drive_max_velocity Max velocity in inches per second.
+     * @param drive_max_acceleration Max acceleration in inches per second squared.
+     * @param drive_max_jerk Max jerk in inches per second cubed, 0 for a trapezoidal profile.
+     */
+    void set_drive_profile_constants(float drive_max_velocity, float drive_max_acceleration, float drive_max_jerk);
+
+    /**
+     * @brief Resets default turn motion profile constants.
+     * Used by turn_to_angle() when profiled is set. The profile setpoint is tracked
+     * with the turn feedforward plus the turn PID.
+     * 
+     * @param turn_max_velocity Max velocity in degrees per second.
+     * @param turn_max_acceleration Max acceleration in degrees per second squared.
+     * @param turn_max_jerk Max jerk in degrees per second cubed, 0 for a trapezoidal profile.
+     */
+    void set_turn_profile_constants(float turn_max_velocity, float turn_max_acceleration, float turn_max_jerk);
+
+    /**
+     * @brief Resets default drive feedforward constants.
+     * Used by profiled motions and path followers to turn a wheel velocity into voltage.
+     * 
+     * @param ks Volts needed to get the drive moving.
+     * @param kv Volts per inch per second.
+     * @param ka Volts per inch per second squared.
+     * @param kp Volts per inch per second of velocity error, 0 to disable feedback.
+     */
+    void set_drive_feedforward_constants(float ks, float kv, float ka, float kp);
+
+    /**
+     * @brief Resets default turn feedforward constants.
+     * Used by profiled turns to turn a turning rate into voltage on each side.
+     * 
+     * @param ks Volts needed to get the robot turning.
+     * @param kv Volts per degree per second.
+     * @param ka Volts per degree per second squared.
+     * @param kp Volts per degree per second of turn rate error, 0 to disable feedback.
+     */
+    void set_turn_feedforward_constants(float ks, float kv, float ka, float kp);
+
+    /**
+     * @brief Applies the drive kS, kV and kA measured by config_characterize_drive()
+     * from drive_feedforward.txt on the SD card. kP is kept.
+     * 
+     * @return True if measured constants were found and applied.
+     */
+    bool load_drive_feedforward_constants();
+
     /**
      * @brief Globally sets the brake mode for both drive motor groups.
      * @param mode coast, brake, hold
      */
     void set_brake_type(vex::brakeType brake);
 
-    /** @brief Yield to the scheduler until motion is finished. */
+    /** @brief Yield to the scheduler until motion is finished. Returns straight away on the control thread, e.g. in a trigger action. */
     void wait();
 
     /** 
@@ -223,9 +384,21 @@ public:
     /** @return True if the robot is in motion. */
     bool is_in_motion();
 
-    /** @brief Cancels the current motion the robot is in. Useful for chaining movements faster */
+    /**
+     * @brief Cancels the current motion the robot is in, and any queued motions. Useful for chaining movements faster.
+     * The control thread stops the motion between ticks and runs its exit, this waits for that before returning.
+     * Starting a new motion while one is running preempts it the same way, without braking.
+     */
     void cancel_motion();
 
+    /**
+     * @brief Stops a task that starts motions, such as the auton, and cancels its motion.
+     * The task is stopped while this holds the locks motions are started under, so it
+     * can't be stopped partway through starting or cancelling a motion and leave them locked.
+     * @param motion_task The task to stop.
+     */
+    void stop_motion_task(vex::task& motion_task);
+
     /**
      * @brief Drives each side of the chassis at the specified voltage.
      * 
@@ -234,6 +407,43 @@ public:
      */
     void drive_with_voltage(float left_voltage, float right_voltage);
 
+    /**
+     * @brief Drives each side of the chassis at a voltage, changing from the last
+     * voltage each side was given by no more than the slew limits allow.
+     * @param left_voltage Voltage (0-12).
+     * @param right_voltage Voltage (0-12).
+     * @param accelerate Largest increase in volts per second, 0 for no limit.
+     * @param decelerate Largest decrease in volts per second, 0 for no limit.
+     */
+    void drive_with_slew(float left_voltage, float right_voltage, float accelerate, float decelerate);
+
+    /**
+     * @brief Drives one side of the chassis through its slew limit and holds the other, for swings.
+     * @param left_side True to drive the left side and hold the right.
+     * @param voltage Voltage (0-12) for the driven side, positive forwards.
+     * @param accelerate Largest increase in volts per second, 0 for no limit.
+     * @param decelerate Largest decrease in volts per second, 0 for no limit.
+     */
+    void swing_with_slew(bool left_side, float voltage, float accelerate, float decelerate);
+
+    /**
+     * @brief Drives each side of the chassis at a velocity using the drive feedforward,
+     * corrected by the measured wheel velocity.
+     * 
+     * @param left_velocity Left wheel velocity in inches per second.
+     * @param right_velocity Right wheel velocity in inches per second.
+     * @param left_acceleration Left wheel acceleration in inches per second squared.
+     * @param right_acceleration Right wheel acceleration in inches per second squared.
+     * @param max_voltage Max voltage on each side out of 12.
+     */
+    void drive_with_velocity(float left_velocity, float right_velocity, float left_acceleration = 0, float right_acceleration = 0, float max_voltage = 12);
+
+    /** @return Left wheel velocity in inches per second, from the drive motor encoders. */
+    float get_left_velocity();
+
+    /** @return Right wheel velocity in inches per second, from the drive motor encoders. */
+    float get_right_velocity();
+
     /**
      * @brief Stops both sides of the drivetrain.
      * @param mode coast, brake, hold
@@ -242,6 +452,9 @@ public:
 
     /** @return Field‑relative inertial heading (deg, 0‑360). */
     float get_absolute_heading();
+
+    /** @return Inertial heading without wrapping, continuous across full turns. */
+    unwrapped_heading get_rotation();
     
     /** @brief Mirror all subsequent turn angles, affecting turn_to_angle(), drive_to_pose(), and set_coordinates(). 
      * Useful on opposite field sides. 
@@ -278,7 +491,7 @@ public:
      * Drive distance does not optimize for direction, so it won't try
      * to drive at the opposite heading from the one given to get there faster.
      * You can control the heading, but if you choose not to, it will drive with the
-     * heading it's currently facing. It uses forward tracker to find distance traveled. 
+     * heading it's facing when the motion starts. It uses forward tracker to find distance traveled. 
      * Use negative distance to go backwards
      * 
      * @param distance Desired distance in inches.
@@ -315,7 +528,8 @@ public:
     /**
      * @brief Resets the robot's coordinates and heading.
      * This is for odom-using robots to specify where the bot is at the beginning
-     * of the match.
+     * of the match. The first call starts the odom task, later calls hand the reset
+     * to it and wait until it's done, as the odom task is the only one that publishes the pose.
      * 
      * @param X_position Robot's x in inches.
      * @param Y_position Robot's y in inches.
@@ -342,6 +556,120 @@ public:
     float get_X_position();
     /** @return The robot's y position in inches */
     float get_Y_position();
+
+    /**
+     * @brief Gets a consistent copy of the robot's pose without locking.
+     * Reading x and y separately can mix two odom updates, use this when they need to match.
+     * @return x, y, theta, the time the pose was measured, and its sequence number.
+     */
+    pose get_pose();
+
+    /**
+     * @brief Gets where the robot was at a past time, for lining up sensor readings
+     * that were taken a few ticks ago with the pose at that moment.
+     *
+     * @param timestamp Time in milliseconds from vex::timer::system().
+     * @param result Filled with the interpolated pose.
+     * @return False if the time is older than the stored history (about 640 ms).
+     */
+    bool get_pose_at(uint32_t timestamp, pose& result);
+
+    /**
+     * @brief Turns on odom precision mode for long runs like skills. Trackers are read as
+     * whole encoder ticks and arc odometry runs in double with compensated summation.
+     * Call before set_coordinates().
+     * @param precise True for precision mode, false for the default float odometry.
+     */
+    void set_odom_precision(bool precise);
+
+    /**
+     * @brief Chooses which estimate get_pose() returns. Both run every tick, so
+     * switching mid-run picks up the other estimate where it is.
+     * @param mode odom_mode::ARC or odom_mode::EKF.
+     */
+    void set_odom_mode(odom_mode mode);
+
+    /**
+     * @brief Turns battery voltage compensation on or off for both sides of the drive, so
+     * motions tuned on a full battery take the same time as it sags.
+     * @param enabled True to compensate.
+     * @param nominal_voltage Battery voltage in volts the constants were tuned at.
+     */
+    void set_voltage_compensation(bool enabled, float nominal_voltage = 12.6);
+
+    /**
+     * @brief Starts recording one entry per finished motion, with how long it took to settle,
+     * the filtered battery voltage, and the ratio the drive outputs were scaled by.
+     */
+    void start_compensation_log();
+
+    /**
+     * @brief Stops recording and writes the log to the SD card.
+     * @param file_name File to create or overwrite.
+     * @return False if there's no SD card or nothing was recorded.
+     */
+    bool save_compensation_log(const std::string& file_name);
+
+    /**
+     * @brief Starts a new early settle report. Every motion that finishes after this adds
+     * how long it ran and how much of its settle time early settling saved.
+     */
+    void start_settle_report();
+
+    /** @return One entry per motion finished since start_settle_report(), oldest first. */
+    std::vector<settle_report_entry> get_settle_report();
+
+    /**
+     * @brief Copies the Kalman filter's covariance, over x (in^2), y (in^2) and heading (rad^2).
+     * @param result Filled with the 3x3 covariance.
+     */
+    void get_pose_covariance(float result[3][3]);
+
+    /**
+     * @brief Adds a distance sensor facing a field wall for localization. Up to 4 can be added.
+     * @param sensor Distance sensor, must outlive the chassis.
+     * @param x_offset Distance right of the robot's center in inches.
+     * @param y_offset Distance in front of the robot's center in inches.
+     * @param angle Degrees the sensor faces from forwards, clockwise positive.
+     */
+    void add_localization_sensor(vex::distance& sensor, float x_offset, float y_offset, float angle);
+
+    /**
+     * @brief Turns wall localization on or off, set per auton after set_coordinates().
+     * While on, the odom task runs the particle filter every 10 ms and pulls the
+     * pose towards its estimate whenever the particles agree.
+     * @param enabled True to correct the pose with the distance sensors.
+     */
+    void set_localization(bool enabled);
+
+    /** @return The tracker, drive encoder, inertial and distance readings odom uses, in inches and degrees. */
+    odom_sample get_odom_sample();
+
+    /**
+     * @brief Starts recording every odom tick's raw sensor readings, for replaying runs
+     * through both estimators later. Memory is reserved up front.
+     * @param max_samples Samples to keep, 12000 is a full minute at 5 ms.
+     */
+    void start_odom_log(size_t max_samples = 12000);
+
+    /**
+     * @brief Stops recording and writes the log to the SD card, starting with the pose
+     * set_coordinates() was last given.
+     * @param file_name File to create or overwrite.
+     * @return False if there's no SD card or nothing was recorded.
+     */
+    bool save_odom_log(const std::string& file_name);
+
+    /**
+     * @brief Runs a saved log through the arc odometry and the Kalman filter.
+     * @param file_name Log written by save_odom_log().
+     * @param arc_result Final pose from arc odometry.
+     * @param ekf_result Final pose from the Kalman filter.
+     * @param mcl_result Final pose from arc odometry corrected by the particle filter, the same as arc_result if no distance sensors were logged.
+     * @param start_result Pose the log started at.
+     * @return False if the log couldn't be read.
+     */
+    bool replay_odom_log(const std::string& file_name, pose& arc_result, pose& ekf_result, pose& mcl_result, pose& start_result);
     
     /**
      * @brief Turns to a specified point on the field.
@@ -417,6 +745,125 @@ public:
     void drive_to_pose(float X_position, float Y_position, float angle, const drive_to_pose_params& p);
 
     void follow_path(std::vector<point> path, const follow_path_params& p);
+
+    /**
+     * @brief Follows a path generated at compile time, see spline.h.
+     * @param path Evenly spaced points, e.g. from catmull_rom_path().
+     */
+    template <size_t N>
+    void follow_path(const std::array<point, N>& path, const follow_path_params& p);
+
+    /** @brief Same as above with the default follow_path_params, which aren't complete yet to be a default argument here. */
+    template <size_t N>
+    void follow_path(const std::array<point, N>& path);
+
+    /**
+     * @brief Follows a time-indexed trajectory with a RAMSETE controller.
+     * Every tick the trajectory is sampled at the elapsed time, and the pose error
+     * is corrected in the robot's frame on top of the sampled linear and angular
+     * velocity. The resulting wheel velocities are turned into voltage with the
+     * drive feedforward. Unlike follow_path() the robot is always told where it should
+     * be right now, so runs repeat the same way even after a bump.
+     * Use generate_trajectory() to build a trajectory from a path.
+     * 
+     * @param trajectory Trajectory samples in time order.
+     * @param b Aggressiveness of the correction in 1/inches squared.
+     * @param zeta Damping of the correction between 0 and 1.
+     * @param min_voltage Minimum voltage on the drive, used for chaining movements.
+     * @param max_voltage Max voltage on each side of the drive out of 12.
+     * @param wait Yields program until motion has finished, true by default.
+     */
+    void follow_trajectory(std::vector<trajectory_point> trajectory, const follow_trajectory_params& p);
+
+    /**
+     * @brief Adds a motion to the back of the motion queue and returns straight away.
+     * Queued motions run one after another on the control thread. Each one is set up on
+     * the tick the one before it finishes, from where the robot is then, and takes over
+     * on the next tick, so there's no gap waiting for a task or for the caller.
+     * 
+     * @param name Shown in the segment timings.
+     * @param start Starts the motion, e.g. [](){ chassis.turn_to_angle(90, { .wait = false }); }.
+     * It runs on the control thread, so the motion must not wait.
+     */
+    void queue_motion(const std::string& name, std::function<void()> start);
+
+    /**
+     * @brief Queues drive_distance(). See queue_motion(). Without a heading in p the segment
+     * holds the heading the robot has when it starts, e.g. the one an earlier turn left it at.
+     * @param exit_velocity Speed in inches per second to hand the next segment, 0 to stop. The
+     * segment won't slow below it and doesn't stop at the end, so pair it with a looser settle_error.
+     */
+    void queue_drive_distance(float distance, drive_distance_params p, float exit_velocity);
+
+    /**
+     * @brief Queues turn_to_angle(). See queue_motion().
+     * @param exit_velocity Turn rate in degrees per second to hand the next segment, 0 to stop.
+     */
+    void queue_turn_to_angle(float angle, turn_to_angle_params p, float exit_velocity);
+
+    /**
+     * @brief Queues drive_to_point(). See queue_drive_distance() for exit_velocity.
+     */
+    void queue_drive_to_point(float X_position, float Y_position, drive_to_point_params p, float exit_velocity);
+
+    /**
+     * @brief Queues drive_to_pose(). See queue_drive_distance() for exit_velocity.
+     */
+    void queue_drive_to_pose(float X_position, float Y_position, float angle, drive_to_pose_params p, float exit_velocity);
+
+    /**
+     * @brief Queues follow_path(). See queue_drive_distance() for exit_velocity.
+     */
+    void queue_follow_path(std::vector<point> path, follow_path_params p, float exit_velocity);
+
+    /** @return Number of segments waiting to run, not counting the one running. */
+    int get_queue_size();
+
+    /** @return True while a queued segment is running or waiting to run. */
+    bool is_queue_running();
+
+    /** @return Timings of every segment queued since the queue last started empty. */
+    std::vector<motion_segment_timing> get_segment_timings();
+
+    /** @brief Drops every segment waiting to run. The running one, if any, finishes normally. */
+    void clear_motion_queue();
+
+    /** @brief Yield to the scheduler until the motion queue has finished. Returns straight away on the control thread. */
+    void wait_for_queue();
+
+    /**
+     * @brief Fires an action once the next motion has travelled a distance.
+     * Triggers attach to the next motion started, or to the next segment queued, and are
+     * checked by the control loop right after every update, so the action runs on exactly
+     * the tick the condition is met. Actions run on the control thread, where waiting is skipped,
+     * so a motion started from one takes over on the next tick and is what wait() then waits on.
+     * Triggers that haven't fired when the motion ends are dropped.
+     * 
+     * @param units Distance travelled, inches for drive motions and degrees for turns.
+     * @param action Called once, e.g. [](){ start_intake(); }.
+     */
+    void add_distance_trigger(float units, std::function<void()> action);
+
+    /**
+     * @brief Fires an action once the robot enters a circle during the next motion. See add_distance_trigger().
+     * @param X_position Center of the circle in inches.
+     * @param Y_position Center of the circle in inches.
+     * @param radius Radius of the circle in inches.
+     */
+    void add_region_trigger(float X_position, float Y_position, float radius, std::function<void()> action);
+
+    /**
+     * @brief Fires an action once the robot faces within tolerance of a heading during the next motion. See add_distance_trigger().
+     * @param angle Field-centric heading in degrees.
+     * @param tolerance Degrees either side of angle.
+     */
+    void add_heading_trigger(float angle, float tolerance, std::function<void()> action);
+
+    /**
+     * @brief Fires an action once the next motion has run for a time. See add_distance_trigger().
+     * @param time Time since the motion started in milliseconds.
+     */
+    void add_time_trigger(float time, std::function<void()> action);
     
     /** @brief disables joystick control of the drivetrain */
     void disable_control();
@@ -442,13 +889,29 @@ public:
     mik::motor_group left_drive;
     mik::motor_group right_drive; 
 
-    bool motion_running;
+    motion_executor executor; // Runs every motion on one fixed-rate control thread.
+    sensor_frame frame; // Captured by the control thread at the start of every tick, motions read sensors from here.
+
+    /** @brief Reads every chassis sensor once into frame. Called by the executor each tick. */
+    void capture_frame();
+
+    /** @return A copy of the last captured frame, safe to call from any task. */
+    sensor_frame get_frame();
+
+    bool motion_running; // Stays set when a motion hands off to the one preempting it, so wait() covers both.
     float distance_traveled;
     
     bool position_tracking;
     bool control_disabled;
   
     drive_mode selected_drive_mode = drive_mode::SPLIT_ARCADE;
+    odom_mode selected_odom_mode = odom_mode::ARC;
+    bool odom_precision = false;
+
+    particle_filter localizer;
+    bool localization_enabled = false;
+    float localization_max_spread = 2; // Particles must agree to within this many inches before the pose is corrected.
+    float localization_gain = .1; // Fraction of the way the pose moves towards the estimate per update.
 
 private:
     bool angles_mirrored_ = false;
@@ -465,25 +928,119 @@ private:
     float sideways_tracker_center_distance;
     float sideways_tracker_inch_to_deg_ratio;
 
-    PID pid; // Primary PID controller.
-    PID pid_2; // Secondary PID controller (heading).
+    struct queued_segment {
+        std::function<void()> start;
+        size_t timing_index; // Index into segment_timings.
+        std::vector<motion_trigger> triggers; // Triggers added before the segment was queued.
+    };
+    std::vector<queued_segment> motion_queue;
+    std::vector<motion_segment_timing> segment_timings;
+    int running_segment = -1; // Index into segment_timings of the running segment, -1 for none.
+    vex::mutex queue_lock;
+    bool preparing_segment = false; // Set while a queued segment is being set up, so its motion is kept instead of started.
+    motion prepared_motion;
+    bool motion_prepared = false;
+
+    std::vector<motion_trigger> pending_triggers; // Attached to the next motion started or segment queued.
+
+    /**
+     * @brief Hands a motion to the executor, or keeps it as the next segment when one is being set up.
+     * Pending triggers are attached to it first.
+     */
+    void start_motion(const motion& new_motion);
+
+    /**
+     * @brief Stops the running motion, or queue, before a new motion sets up, handing off the
+     * current wheel voltages instead of braking. Called first thing by every motion, and waits
+     * until the old motion has finished so the two never update at once. Each motion owns
+     * its controllers, so setting up the new one leaves the old one's untouched either way.
+     */
+    void preempt_motion();
+
+    /**
+     * @brief Sets up the next queued segment. Called by the executor whenever no motion is running.
+     * @param next Set to the segment's motion.
+     * @return False if the queue is empty.
+     */
+    bool next_queued_motion(motion& next);
+
+    slew_limiter left_slew; // Tracks the last voltage given to the left side.
+    slew_limiter right_slew; // Tracks the last voltage given to the right side.
     odom odom;
 
     vex::task odom_task;
-    vex::task drive_task;
+    bool odom_task_started = false;
+    pose_seqlock pose_lock; // Published by position_track(), read by get_pose().
+    pose pending_coordinates; // Reset handed to the odom task by set_coordinates().
+    volatile bool coordinates_pending = false; // Set by set_coordinates(), cleared by the odom task once it has applied the reset.
+
+    /**
+     * @brief Moves every pose estimate to new, already mirrored, coordinates and publishes them.
+     * Only called by the odom task, or before it has started.
+     */
+    void apply_coordinates(float X_position, float Y_position, float orientation_deg);
+    pose_history history; // Filled by position_track(), read by get_pose_at().
+    vex::mutex frame_lock;
+    pose_ekf ekf; // Runs next to odom, published instead of it in odom_mode::EKF.
+
+    std::vector<odom_sample> odom_log;
+    bool logging_odom = false;
+    pose log_start; // Pose given to set_coordinates(), saved at the top of the log.
+
+    struct compensation_entry {
+        uint32_t timestamp; // When the motion finished, in milliseconds.
+        uint32_t duration; // How long the motion ran, in milliseconds.
+        float battery_voltage; // Filtered battery voltage in volts.
+        float ratio; // Ratio the drive outputs were scaled by.
+    };
+    std::vector<compensation_entry> compensation_log;
+    bool logging_compensation = false;
+
+    std::vector<settle_report_entry> settle_report;
+    bool reporting_settle = false;
+    settle_report_entry finished_settle; // Left by a motion finishing on its own for on_finish to report, empty when it was cancelled.
+
+    /** @brief Called by a motion as it finishes on its own, while its PID still holds how it settled. */
+    void report_settle(const PID& settled_pid);
+
+    /** @return Tracker position in hundredths of a degree, the rotation sensor's own resolution. */
+    int32_t get_ForwardTracker_ticks();
+    int32_t get_SidewaysTracker_ticks();
+    /** @return Inertial heading in degrees (0-360) without rounding through float. */
+    double get_precise_heading();
+
+    std::array<vex::distance*, particle_filter::max_beams> localization_sensors = {};
+    odom_sample last_localized; // Sample the particle filter last moved from.
+
+    /**
+     * @brief Runs one particle filter step between two samples and pulls position towards the estimate.
+     * @param filter Particle filter to step, the live one or a copy when replaying.
+     * @param from Sample the filter last moved from.
+     * @param to Current sample.
+     * @param position Position to correct in place.
+     */
+    void localize(particle_filter& filter, const odom_sample& from, const odom_sample& to, point& position);
 };
 
 extern Chassis chassis;
 
 struct drive_distance_params {
-    float heading = chassis.get_absolute_heading();
+    float heading = NAN; // Heading to hold, NAN for whichever way the robot faces when the motion starts.
     float min_voltage = chassis.drive_min_voltage;
     float max_voltage = chassis.drive_max_voltage;
     float heading_max_voltage = chassis.heading_max_voltage;
     float settle_error = chassis.drive_settle_error;
     float settle_time = chassis.drive_settle_time;
+    float settle_velocity = chassis.drive_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.drive_settle_confirm_time;
     float timeout = chassis.drive_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
+    bool profiled = false; // Follow a motion profile instead of feeding the full error into PID.
+    float max_velocity = chassis.drive_max_velocity;
+    float max_acceleration = chassis.drive_max_acceleration;
+    float max_jerk = chassis.drive_max_jerk;
 };
 
 struct turn_to_angle_params {
@@ -492,8 +1049,16 @@ struct turn_to_angle_params {
     float max_voltage = chassis.turn_max_voltage;
     float settle_error = chassis.turn_settle_error;
     float settle_time = chassis.turn_settle_time;
+    float settle_velocity = chassis.turn_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.turn_settle_confirm_time;
     float timeout = chassis.turn_timeout;
-    bool wait = true;   
+    bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
+    bool profiled = false; // Follow a motion profile instead of feeding the full error into PID.
+    float max_velocity = chassis.turn_max_velocity;
+    float max_acceleration = chassis.turn_max_acceleration;
+    float max_jerk = chassis.turn_max_jerk;
 };
 
 struct swing_to_angle_params {
@@ -502,8 +1067,12 @@ struct swing_to_angle_params {
     float max_voltage = chassis.swing_max_voltage;
     float settle_error = chassis.swing_settle_error;
     float settle_time = chassis.swing_settle_time;
+    float settle_velocity = chassis.swing_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.swing_settle_confirm_time;
     float timeout = chassis.swing_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
 };
 
 struct drive_to_point_params {
@@ -512,8 +1081,12 @@ struct drive_to_point_params {
     float heading_max_voltage = chassis.heading_max_voltage;
     float settle_error = chassis.drive_settle_error;
     float settle_time = chassis.drive_settle_time;
+    float settle_velocity = chassis.drive_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.drive_settle_confirm_time;
     float timeout = chassis.drive_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
 };
 
 struct drive_to_pose_params {
@@ -524,8 +1097,12 @@ struct drive_to_pose_params {
     float heading_max_voltage = chassis.heading_max_voltage;
     float settle_error = chassis.drive_settle_error;
     float settle_time = chassis.drive_settle_time;
+    float settle_velocity = chassis.drive_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.drive_settle_confirm_time;
     float timeout = chassis.drive_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
 };
 
 struct turn_to_point_params {
@@ -535,8 +1112,12 @@ struct turn_to_point_params {
     float max_voltage = chassis.turn_max_voltage;
     float settle_error = chassis.turn_settle_error;
     float settle_time = chassis.turn_settle_time;
+    float settle_velocity = chassis.turn_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.turn_settle_confirm_time;
     float timeout = chassis.turn_timeout;
-    bool wait = true;   
+    bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
 };
 
 struct swing_to_point_params {
@@ -546,8 +1127,12 @@ struct swing_to_point_params {
     float max_voltage = chassis.swing_max_voltage;
     float settle_error = chassis.swing_settle_error;
     float settle_time = chassis.swing_settle_time;
+    float settle_velocity = chassis.swing_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.swing_settle_confirm_time;
     float timeout = chassis.swing_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
 };
 
 struct follow_path_params {
@@ -557,65 +1142,86 @@ struct follow_path_params {
     float heading_max_voltage = chassis.heading_max_voltage;
     float settle_error = chassis.drive_settle_error;
     float settle_time = chassis.drive_settle_time;
+    float settle_velocity = chassis.drive_settle_velocity; // 0 to always wait out settle_time.
+    float settle_confirm_time = chassis.drive_settle_confirm_time;
     float timeout = chassis.drive_timeout;
     bool wait = true;
+    float slew_accelerate = chassis.drive_slew_accelerate; // Volts per second, 0 for no limit.
+    float slew_decelerate = chassis.drive_slew_decelerate; // Volts per second, 0 for no limit.
+    bool profiled = false; // Drive at a curvature-limited velocity profile instead of PID towards the lookahead point.
+    float max_velocity = chassis.drive_max_velocity;
+    float max_acceleration = chassis.drive_max_acceleration;
+    float max_lateral_acceleration = chassis.pursuit_max_lateral_acceleration;
+    float spacing = 1; // Distance between resampled path points in inches.
 };
 
-extern drive_distance_params g_drive_distance_params_buffer;
-extern turn_to_angle_params g_turn_to_angle_params_buffer;
-extern swing_to_angle_params g_swing_to_angle_params_buffer;
-extern turn_to_point_params g_turn_to_point_params_buffer;
-extern swing_to_point_params g_swing_to_point_params_buffer;
-extern drive_to_point_params g_drive_to_point_params_buffer;
-extern drive_to_pose_params g_drive_to_pose_params_buffer;
-extern follow_path_params g_follow_path_params_buffer;
+struct follow_trajectory_params {
+    float b = chassis.ramsete_b;
+    float zeta = chassis.ramsete_zeta;
+    float min_voltage = chassis.drive_min_voltage;
+    float max_voltage = chassis.drive_max_voltage;
+    bool wait = true;
+};
 
 inline void Chassis::drive_distance(float distance, const drive_distance_params& p = drive_distance_params{}) {
+  preempt_motion();
+  // Resolved here rather than in the params, so a queued segment holds the heading it starts at.
+  const float heading = std::isnan(p.heading) ? get_absolute_heading() : p.heading;
   desired_distance = distance;
-  desired_heading = p.heading;
-  g_drive_distance_params_buffer = p;
+  desired_heading = heading;
+  desired_target = { "drive_distance", true, get_X_position() + distance * sin(to_rad(heading)), get_Y_position() + distance * cos(to_rad(heading)), true, heading };
 
-  pid = PID(distance, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout);
-  pid_2 = PID(reduce_negative_180_to_180(p.heading - get_absolute_heading()), heading_kp, heading_ki, heading_kd, heading_starti);
+  PID pid(distance, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
+  PID pid_2(get_rotation().error_to(heading), heading_kp, heading_ki, heading_kd, heading_starti);
   
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float distance = chassis.desired_distance;
-    const float heading = chassis.desired_heading;
-    drive_distance_params p = g_drive_distance_params_buffer;
+  float drive_start_position = get_ForwardTracker_position();
+  float prev_drive_error = distance;
 
-    float drive_start_position = chassis.get_ForwardTracker_position();
-    float current_position = drive_start_position;
+  motion_profile profile;
+  if (p.profiled) {
+    profile = motion_profile(distance, p.max_velocity, p.max_acceleration, p.max_jerk);
+  }
+  float profile_time = 0;
 
-    float drive_error = distance + drive_start_position - current_position;
-    float prev_drive_error = drive_error;
+  start_motion({
+    [this, pid, pid_2, distance, heading, p, drive_start_position, prev_drive_error, profile, profile_time]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
 
-    while (chassis.pid.is_settled() == false) {
-      current_position = chassis.get_ForwardTracker_position();
+      float current_position = frame.forward_tracker;
   
-      drive_error = distance + drive_start_position - current_position;
-      chassis.distance_traveled += std::abs(drive_error - prev_drive_error);
+      float drive_error = distance + drive_start_position - current_position;
+      distance_traveled += std::abs(drive_error - prev_drive_error);
       prev_drive_error = drive_error;
 
-      float heading_error = reduce_negative_180_to_180(heading - chassis.get_absolute_heading());
-      float drive_output = chassis.pid.compute(drive_error);
-      float heading_output = chassis.pid_2.compute(heading_error);
+      float feedforward = 0;
+      if (p.profiled) {
+        // Track the profile setpoint instead of the final target, and don't let the motion settle until the profile is done.
+        profile_time += executor.dt / 1000;
+        profile_point setpoint = profile.sample(profile_time);
+        drive_error = setpoint.position + drive_start_position - current_position;
+        feedforward = drive_feedforward.compute(setpoint.velocity, setpoint.acceleration, (frame.left_velocity + frame.right_velocity) / 2);
+        if (profile_time < profile.get_duration()) { pid.time_spent_settled = 0; pid.time_spent_still = 0; }
+      }
+
+      float heading_error = frame.rotation.error_to(heading);
+      float drive_output = feedforward + pid.compute(drive_error, executor.dt);
+      float heading_output = pid_2.compute(heading_error, executor.dt);
   
       drive_output = clamp(drive_output, -p.max_voltage, p.max_voltage);
       heading_output = clamp(heading_output, -p.heading_max_voltage, p.heading_max_voltage);
       
       drive_output = clamp_min_voltage(drive_output, p.min_voltage);
 
-      chassis.drive_with_voltage(drive_output + heading_output, drive_output - heading_output);
-      vex::task::sleep(10);
+      drive_with_slew(drive_output + heading_output, drive_output - heading_output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) {
     this->wait();
@@ -623,403 +1229,406 @@ inline void Chassis::drive_distance(float distance, const drive_distance_params&
 }
 
 inline void Chassis::turn_to_angle(float angle, const turn_to_angle_params& p = turn_to_angle_params{}) {
+  preempt_motion();
   desired_angle = mirror_angle(angle, angles_mirrored_);
-  g_turn_to_angle_params_buffer = p;
 
-  pid = PID(angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_)), turn_kp, turn_ki, turn_kd, turn_starti, p.settle_error, p.settle_time, p.timeout);
+  PID pid(chassis.get_rotation().error_to(angle, mirror_direction(p.turn_direction, chassis.angles_mirrored_)), turn_kp, turn_ki, turn_kd, turn_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
   
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float angle = chassis.desired_angle;
-    const turn_to_angle_params p = g_turn_to_angle_params_buffer;
+  angle = desired_angle;
+  desired_target = { "turn_to_angle", false, 0, 0, true, angle };
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle);
+  float prev_error = get_rotation().error_to(angle, turn_direction);
+
+  unwrapped_heading start_heading = get_rotation();
+  unwrapped_heading prev_heading = start_heading;
+  motion_profile profile;
+  if (p.profiled) {
+    profile = motion_profile(prev_error, p.max_velocity, p.max_acceleration, p.max_jerk);
+  }
+  float profile_time = 0;
 
-    bool crossed = false;
-    float raw_error = angle_error(angle - chassis.get_absolute_heading());
-    float error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
+  start_motion({
+    [this, pid, angle, turn_direction, p, crossed, prev_error, prev_raw_error, start_heading, prev_heading, profile, profile_time]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
 
-    while(chassis.pid.is_settled() == false) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading());
+      float raw_error = frame.rotation.error_to(angle);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle, turn_direction);
       }
       
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) break;
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float feedforward = 0;
+      if (p.profiled) {
+        // Track the profile setpoint instead of the final target, and don't let the motion settle until the profile is done.
+        profile_time += executor.dt / 1000;
+        profile_point setpoint = profile.sample(profile_time);
+        error = frame.rotation.error_to(start_heading.unwrapped() + setpoint.position);
+        float turn_rate = executor.dt > 0 ? frame.rotation.turned_since(prev_heading) / (executor.dt / 1000) : 0;
+        feedforward = turn_feedforward.compute(setpoint.velocity, setpoint.acceleration, turn_rate);
+        prev_heading = frame.rotation;
+        if (profile_time < profile.get_duration()) { pid.time_spent_settled = 0; pid.time_spent_still = 0; }
+      }
+
+      float output = feedforward + pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
 
-      chassis.drive_with_voltage(output, -output);
-      vex::task::sleep(10); 
+      drive_with_slew(output, -output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-  
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }
 }
 
 inline void Chassis::left_swing_to_angle(float angle, const swing_to_angle_params& p = swing_to_angle_params{}) {
+  preempt_motion();
   desired_angle = mirror_angle(angle, angles_mirrored_);
-  g_swing_to_angle_params_buffer = p;
 
-  pid = PID(angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_)), swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout);
+  PID pid(chassis.get_rotation().error_to(angle, mirror_direction(p.turn_direction, chassis.angles_mirrored_)), swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float angle = chassis.desired_angle;
-    const swing_to_angle_params p = g_swing_to_angle_params_buffer;
+  angle = desired_angle;
+  desired_target = { "left_swing_to_angle", false, 0, 0, true, angle };
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle);
+  float prev_error = get_rotation().error_to(angle, turn_direction);
 
-    bool crossed = false;
-    float raw_error = angle_error(angle - chassis.get_absolute_heading());
-    float error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
+  start_motion({
+    [this, pid, angle, turn_direction, p, crossed, prev_error, prev_raw_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
 
-    while(!chassis.pid.is_settled()) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading());
+      float raw_error = frame.rotation.error_to(angle);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle, turn_direction);
       }
       
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { break; }
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float output = pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
   
-      chassis.left_drive.spin(fwd, output, volt);
-      chassis.right_drive.stop(hold);
-  
-      vex::task::sleep(10);
+      swing_with_slew(true, output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }    
 }
 
 inline void Chassis::right_swing_to_angle(float angle, const swing_to_angle_params& p = swing_to_angle_params{}) {
+  preempt_motion();
   desired_angle = mirror_angle(angle, angles_mirrored_);
-  g_swing_to_angle_params_buffer = p;
 
-  pid = PID(angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_)), swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout);
+  PID pid(chassis.get_rotation().error_to(angle, mirror_direction(p.turn_direction, chassis.angles_mirrored_)), swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float angle = chassis.desired_angle;
-    const swing_to_angle_params p = g_swing_to_angle_params_buffer;
+  angle = desired_angle;
+  desired_target = { "right_swing_to_angle", false, 0, 0, true, angle };
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle);
+  float prev_error = get_rotation().error_to(angle, turn_direction);
 
-    bool crossed = false;
-    float raw_error = angle_error(angle - chassis.get_absolute_heading());
-    float error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
+  start_motion({
+    [this, pid, angle, turn_direction, p, crossed, prev_error, prev_raw_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
 
-    while(!chassis.pid.is_settled()) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading());
+      float raw_error = frame.rotation.error_to(angle);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading(), mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle, turn_direction);
       }
       
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) break;
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float output = pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
   
-      chassis.right_drive.spin(reverse, output, volt);
-      chassis.left_drive.stop(hold);
-  
-      vex::task::sleep(10);
+      swing_with_slew(false, -output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }    
 }
 
 inline void Chassis::turn_to_point(float X_position, float Y_position, const turn_to_point_params& p = turn_to_point_params{}) {
+  preempt_motion();
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
 
   desired_X_position = X_position;
   desired_Y_position = Y_position;
   desired_angle_offset = p.angle_offset;
-  g_turn_to_point_params_buffer = p;
 
-  float start_angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
-  float start_error = angle_error(start_angle - chassis.get_absolute_heading() + p.angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-  pid = PID(start_error, turn_kp, turn_ki, turn_kd, turn_starti, p.settle_error, p.settle_time, p.timeout);
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  const float angle_offset = p.angle_offset;
+  const float angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
+  desired_target = { "turn_to_point", false, 0, 0, true, angle + angle_offset };
+  float start_error = get_rotation().error_to(angle + angle_offset, turn_direction);
+  PID pid(start_error, turn_kp, turn_ki, turn_kd, turn_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float x_pos = chassis.desired_X_position;
-    const float y_pos = chassis.desired_Y_position;
-    const float angle_offset = chassis.desired_angle_offset;
-    const turn_to_point_params p = g_turn_to_point_params_buffer;
-
-    bool crossed = false;
-    float angle = to_deg(atan2((x_pos - chassis.get_X_position()), (y_pos - chassis.get_Y_position())));
-    float raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
-    float error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
-
-    while(!chassis.pid.is_settled()) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle + angle_offset);
+  float prev_error = start_error;
+
+  start_motion({
+    [this, pid, angle, angle_offset, turn_direction, p, crossed, prev_error, prev_raw_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
+
+      float raw_error = frame.rotation.error_to(angle + angle_offset);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle + angle_offset, turn_direction);
       }
 
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) break;
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float output = pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
 
-      chassis.drive_with_voltage(output, -output);
-      task::sleep(10);
+      drive_with_slew(output, -output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }
 }
 
 inline void Chassis::left_swing_to_point(float X_position, float Y_position, const swing_to_point_params& p = swing_to_point_params{}) {
+  preempt_motion();
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
 
   desired_X_position = X_position;
   desired_Y_position = Y_position;
   desired_angle_offset = p.angle_offset;
-  g_swing_to_point_params_buffer = p;
 
-  float start_angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
-  float start_error = angle_error(start_angle - chassis.get_absolute_heading() + p.angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-  pid = PID(start_error, swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout);
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  const float angle_offset = p.angle_offset;
+  const float angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
+  desired_target = { "left_swing_to_point", false, 0, 0, true, angle + angle_offset };
+  float start_error = get_rotation().error_to(angle + angle_offset, turn_direction);
+  PID pid(start_error, swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float x_pos = chassis.desired_X_position;
-    const float y_pos = chassis.desired_Y_position;
-    const float angle_offset = chassis.desired_angle_offset;
-    const swing_to_point_params p = g_swing_to_point_params_buffer;
-
-    bool crossed = false;
-    float angle = to_deg(atan2((x_pos - chassis.get_X_position()), (y_pos - chassis.get_Y_position())));
-    float raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
-    float error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
-
-    while(!chassis.pid.is_settled()) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle + angle_offset);
+  float prev_error = start_error;
+
+  start_motion({
+    [this, pid, angle, angle_offset, turn_direction, p, crossed, prev_error, prev_raw_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
+
+      float raw_error = frame.rotation.error_to(angle + angle_offset);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle + angle_offset, turn_direction);
       }
 
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { break; }
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float output = pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
 
-      chassis.left_drive.spin(fwd, output, volt);
-      chassis.right_drive.stop(hold);
-
-      task::sleep(10);
+      swing_with_slew(true, output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }  
 }
 
 inline void Chassis::right_swing_to_point(float X_position, float Y_position, const swing_to_point_params& p = swing_to_point_params{}) {
+  preempt_motion();
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
 
   desired_X_position = X_position;
   desired_Y_position = Y_position;
   desired_angle_offset = p.angle_offset;
-  g_swing_to_point_params_buffer = p;
 
-  float start_angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
-  float start_error = angle_error(start_angle - chassis.get_absolute_heading() + p.angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-  pid = PID(start_error, swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout);
+  const direction turn_direction = mirror_direction(p.turn_direction, angles_mirrored_);
+  const float angle_offset = p.angle_offset;
+  const float angle = to_deg(atan2((X_position - get_X_position()), (Y_position - get_Y_position())));
+  desired_target = { "right_swing_to_point", false, 0, 0, true, angle + angle_offset };
+  float start_error = get_rotation().error_to(angle + angle_offset, turn_direction);
+  PID pid(start_error, swing_kp, swing_ki, swing_kd, swing_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float x_pos = chassis.desired_X_position;
-    const float y_pos = chassis.desired_Y_position;
-    const float angle_offset = chassis.desired_angle_offset;
-    const swing_to_point_params p = g_swing_to_point_params_buffer;
-
-    bool crossed = false;
-    float angle = to_deg(atan2((x_pos - chassis.get_X_position()), (y_pos - chassis.get_Y_position())));
-    float raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
-    float error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
-    float prev_error = error;
-    float prev_raw_error = raw_error;
-
-    while(!chassis.pid.is_settled()) {
-      raw_error = angle_error(angle - chassis.get_absolute_heading() + angle_offset);
+  bool crossed = false;
+  float prev_raw_error = get_rotation().error_to(angle + angle_offset);
+  float prev_error = start_error;
+
+  start_motion({
+    [this, pid, angle, angle_offset, turn_direction, p, crossed, prev_error, prev_raw_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
+
+      float raw_error = frame.rotation.error_to(angle + angle_offset);
       if (sign(raw_error) != sign(prev_raw_error)) {
         crossed = true;
       }
       prev_raw_error = raw_error;
       
+      float error;
       if (crossed) {
         error = raw_error;
       } else {
-        error = angle_error(angle - chassis.get_absolute_heading() + angle_offset, mirror_direction(p.turn_direction, chassis.angles_mirrored_));
+        error = frame.rotation.error_to(angle + angle_offset, turn_direction);
       }
 
-      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { break; }
-      chassis.distance_traveled += std::abs(error - prev_error);
+      if (p.min_voltage != 0 && sign(error) != sign(prev_error)) { report_settle(pid); return false; }
+      distance_traveled += std::abs(error - prev_error);
 
       prev_error = error;
 
-      float output = chassis.pid.compute(error);
+      float output = pid.compute(error, executor.dt);
       output = clamp(output, -p.max_voltage, p.max_voltage);
       output = clamp_min_voltage(output, p.min_voltage);
 
-      chassis.right_drive.spin(reverse, output, volt);
-      chassis.left_drive.stop(hold);
-
-      task::sleep(10);
+      swing_with_slew(false, -output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
   if (p.wait) { this->wait(); }  
 }
 
 inline void Chassis::drive_to_point(float X_position, float Y_position, const drive_to_point_params& p = drive_to_point_params{}) {
+  preempt_motion();
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
 
   desired_X_position = X_position;
   desired_Y_position = Y_position;
-  g_drive_to_point_params_buffer = p;
 
-  pid = PID(hypot(X_position - get_X_position(), Y_position - get_Y_position()), drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout);
+  PID pid(hypot(X_position - get_X_position(), Y_position - get_Y_position()), drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
   desired_heading = to_deg(atan2(X_position - get_X_position(),Y_position - get_Y_position()));
-  pid_2 = PID(desired_heading - get_absolute_heading(), heading_kp, heading_ki, heading_kd, heading_starti);
+  desired_target = { "drive_to_point", true, X_position, Y_position, false, 0 };
+  PID pid_2(desired_heading - get_absolute_heading(), heading_kp, heading_ki, heading_kd, heading_starti);
 
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float x_pos = chassis.desired_X_position;
-    const float y_pos = chassis.desired_Y_position;
-    const float heading = chassis.desired_heading;
-    const drive_to_point_params p = g_drive_to_point_params_buffer;
+  const float x_pos = X_position;
+  const float y_pos = Y_position;
+  const float heading = desired_heading;
+  bool prev_line_settled = is_line_settled(x_pos, y_pos, heading, get_X_position(), get_Y_position());
+  float prev_drive_error = hypot(x_pos - get_X_position(), y_pos - get_Y_position());
 
-    bool line_settled = false;
-    bool prev_line_settled = is_line_settled(x_pos, y_pos, heading, chassis.get_X_position(), chassis.get_Y_position());
-    float drive_error = hypot(x_pos - chassis.get_X_position(), y_pos - chassis.get_Y_position());
-    float prev_drive_error = drive_error;
+  start_motion({
+    [this, pid, pid_2, x_pos, y_pos, heading, p, prev_line_settled, prev_drive_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
+      pose current = frame.odom_pose;
 
-    while(!chassis.pid.is_settled()){
-      line_settled = is_line_settled(x_pos, y_pos, heading, chassis.get_X_position(), chassis.get_Y_position());
-      if (line_settled && !prev_line_settled) { break; }
+      bool line_settled = is_line_settled(x_pos, y_pos, heading, current.x, current.y);
+      if (line_settled && !prev_line_settled) { report_settle(pid); return false; }
       prev_line_settled = line_settled;
   
-      drive_error = hypot(x_pos - chassis.get_X_position(), y_pos - chassis.get_Y_position());
-      chassis.distance_traveled += std::abs(drive_error - prev_drive_error);
+      float drive_error = hypot(x_pos - current.x, y_pos - current.y);
+      distance_traveled += std::abs(drive_error - prev_drive_error);
       prev_drive_error = drive_error;
 
-      float heading_error = reduce_negative_180_to_180(to_deg(atan2(x_pos - chassis.get_X_position(), y_pos - chassis.get_Y_position())) - chassis.get_absolute_heading());
-      float drive_output = chassis.pid.compute(drive_error);
+      float heading_error = frame.rotation.error_to(to_deg(atan2(x_pos - current.x, y_pos - current.y)));
+      float drive_output = pid.compute(drive_error, executor.dt);
   
       float heading_scale_factor = cos(to_rad(heading_error));
       drive_output *= heading_scale_factor;
       heading_error = reduce_negative_90_to_90(heading_error);
-      float heading_output = chassis.pid_2.compute(heading_error);
+      float heading_output = pid_2.compute(heading_error, executor.dt);
       
       if (drive_error < p.settle_error) { heading_output = 0; }
   
@@ -1028,20 +1637,20 @@ inline void Chassis::drive_to_point(float X_position, float Y_position, const dr
   
       drive_output = clamp_min_voltage(drive_output, p.min_voltage);
   
-      chassis.drive_with_voltage(left_voltage_scaling(drive_output, heading_output), right_voltage_scaling(drive_output, heading_output));
-      vex::task::sleep(10);
+      drive_with_slew(left_voltage_scaling(drive_output, heading_output), right_voltage_scaling(drive_output, heading_output), p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
 
   if (p.wait) { this->wait(); }
 }
 
 inline void Chassis::drive_to_pose(float X_position, float Y_position, float angle, const drive_to_pose_params& p = drive_to_pose_params{}) {
+  preempt_motion();
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
   angle = mirror_angle(angle, angles_mirrored_);
@@ -1049,85 +1658,81 @@ inline void Chassis::drive_to_pose(float X_position, float Y_position, float ang
   desired_X_position = X_position;
   desired_Y_position = Y_position;
   desired_angle = angle;
-  g_drive_to_pose_params_buffer = p;
+  desired_target = { "drive_to_pose", true, X_position, Y_position, true, angle };
 
   float target_distance = hypot(X_position - get_X_position(), Y_position - get_Y_position());
-  pid = PID(target_distance, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout);
-  pid_2 = PID(to_deg(atan2(X_position - get_X_position(), Y_position - get_Y_position())) - get_absolute_heading(), heading_kp, heading_ki, heading_kd, heading_starti);
+  PID pid(target_distance, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
+  PID pid_2(to_deg(atan2(X_position - get_X_position(), Y_position - get_Y_position())) - get_absolute_heading(), heading_kp, heading_ki, heading_kd, heading_starti);
   
   motion_running = true;
   distance_traveled = 0;
 
-  drive_task = vex::task([](){
-    const float x_pos = chassis.desired_X_position;
-    const float y_pos = chassis.desired_Y_position;
-    const float angle = chassis.desired_angle;
-    const drive_to_pose_params p = g_drive_to_pose_params_buffer;
-
-    bool line_settled = is_line_settled(x_pos, y_pos, angle, chassis.get_X_position(), chassis.get_Y_position());
-    bool prev_line_settled = is_line_settled(x_pos, y_pos, angle, chassis.get_X_position(), chassis.get_Y_position());
-    bool crossed_center_line = false;
-    bool center_line_side = is_line_settled(x_pos, y_pos, angle + 90, chassis.get_X_position(), chassis.get_Y_position());
-    bool prev_center_line_side = center_line_side;
-
-    float target_distance = hypot(x_pos - chassis.get_X_position(), y_pos - chassis.get_Y_position());
-    float carrot_X = x_pos- sin(to_rad(angle)) * (p.lead * target_distance + p.setback);
-    float carrot_Y = y_pos - cos(to_rad(angle)) * (p.lead * target_distance + p.setback);
-    float drive_error = hypot(carrot_X - chassis.get_X_position(), carrot_Y - chassis.get_Y_position());
-    float prev_drive_error = drive_error;
-
-    while(!chassis.pid.is_settled()){
-      line_settled = is_line_settled(x_pos, y_pos, angle, chassis.get_X_position(), chassis.get_Y_position());
-      if (line_settled && !prev_line_settled) { break; }
+  const float x_pos = X_position;
+  const float y_pos = Y_position;
+  bool prev_line_settled = is_line_settled(x_pos, y_pos, angle, get_X_position(), get_Y_position());
+  bool crossed_center_line = false;
+  bool prev_center_line_side = is_line_settled(x_pos, y_pos, angle + 90, get_X_position(), get_Y_position());
+
+  float carrot_X = x_pos - sin(to_rad(angle)) * (p.lead * target_distance + p.setback);
+  float carrot_Y = y_pos - cos(to_rad(angle)) * (p.lead * target_distance + p.setback);
+  float prev_drive_error = hypot(carrot_X - get_X_position(), carrot_Y - get_Y_position());
+
+  start_motion({
+    [this, pid, pid_2, x_pos, y_pos, angle, p, prev_line_settled, crossed_center_line, prev_center_line_side, prev_drive_error]() mutable {
+      if (pid.is_settled()) { report_settle(pid); return false; }
+      pose current = frame.odom_pose;
+
+      bool line_settled = is_line_settled(x_pos, y_pos, angle, current.x, current.y);
+      if (line_settled && !prev_line_settled) { report_settle(pid); return false; }
       prev_line_settled = line_settled;
   
-      center_line_side = is_line_settled(x_pos, y_pos, angle + 90, chassis.get_X_position(), chassis.get_Y_position());
+      bool center_line_side = is_line_settled(x_pos, y_pos, angle + 90, current.x, current.y);
       if (center_line_side != prev_center_line_side) {
         crossed_center_line = true;
       }
   
-      target_distance = hypot(x_pos - chassis.get_X_position(), y_pos - chassis.get_Y_position());
+      float target_distance = hypot(x_pos - current.x, y_pos - current.y);
   
-      carrot_X = x_pos - sin(to_rad(angle)) * (p.lead * target_distance + p.setback);
-      carrot_Y = y_pos - cos(to_rad(angle)) * (p.lead * target_distance + p.setback);
+      float carrot_X = x_pos - sin(to_rad(angle)) * (p.lead * target_distance + p.setback);
+      float carrot_Y = y_pos - cos(to_rad(angle)) * (p.lead * target_distance + p.setback);
   
-      drive_error = hypot(carrot_X - chassis.get_X_position(), carrot_Y - chassis.get_Y_position());
-      chassis.distance_traveled += std::abs(drive_error - prev_drive_error);
+      float drive_error = hypot(carrot_X - current.x, carrot_Y - current.y);
+      distance_traveled += std::abs(drive_error - prev_drive_error);
       prev_drive_error = drive_error;
 
-      float heading_error = reduce_negative_180_to_180(to_deg(atan2(carrot_X - chassis.get_X_position(), carrot_Y - chassis.get_Y_position())) - chassis.get_absolute_heading());
+      float heading_error = frame.rotation.error_to(to_deg(atan2(carrot_X - current.x, carrot_Y - current.y)));
   
       if (drive_error < p.settle_error || crossed_center_line || drive_error < p.setback) { 
-        heading_error = reduce_negative_180_to_180(angle - chassis.get_absolute_heading()); 
+        heading_error = frame.rotation.error_to(angle); 
         drive_error = target_distance;
       }
       
-      float drive_output = chassis.pid.compute(drive_error);
+      float drive_output = pid.compute(drive_error, executor.dt);
   
       float heading_scale_factor = cos(to_rad(heading_error));
       drive_output *= heading_scale_factor;
       heading_error = reduce_negative_90_to_90(heading_error);
-      float heading_output = chassis.pid_2.compute(heading_error);
+      float heading_output = pid_2.compute(heading_error, executor.dt);
   
       drive_output = clamp(drive_output, -fabs(heading_scale_factor) * p.max_voltage, fabs(heading_scale_factor) * p.max_voltage);
       heading_output = clamp(heading_output, -p.heading_max_voltage, p.heading_max_voltage);
   
       drive_output = clamp_min_voltage(drive_output, p.min_voltage);
   
-      chassis.drive_with_voltage(left_voltage_scaling(drive_output, heading_output), right_voltage_scaling(drive_output, heading_output));
-      vex::task::sleep(10);
+      drive_with_slew(left_voltage_scaling(drive_output, heading_output), right_voltage_scaling(drive_output, heading_output), p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
-
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
-
-    return 0;
   });
 
   if (p.wait) { this->wait(); }
 }
 
 inline void Chassis::follow_path(std::vector<point> path, const follow_path_params& p = follow_path_params{}) {
+  preempt_motion();
   if (x_pos_mirrored_) {
     for (auto& point : path) {
       point.x = -point.x;
@@ -1140,80 +1745,195 @@ inline void Chassis::follow_path(std::vector<point> path, const follow_path_para
     }
   }
 
-  pid = PID(0, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout);
-  pid_2 = PID(0, heading_kp, heading_ki, heading_kd, heading_starti);
+  PID pid(0, drive_kp, drive_ki, drive_kd, drive_starti, p.settle_error, p.settle_time, p.timeout, p.settle_velocity, p.settle_confirm_time);
+  PID pid_2(0, heading_kp, heading_ki, heading_kd, heading_starti);
 
   motion_running = true;
   distance_traveled = 0;
 
+  pose start = get_pose();
+  point start_position = { start.x, start.y };
+
 	// Add current position to the start of the path so that intersections can be found initially, even if the robot is off the path.
-  path.insert(path.begin(), odom.position);
+  path.insert(path.begin(), start_position);
 
   desired_path = path;
-  g_follow_path_params_buffer = p;
-  
-  drive_task = vex::task([](){
-    std::vector<point> path = chassis.desired_path;
-    follow_path_params p = g_follow_path_params_buffer;
-
-    point target_intersection = chassis.odom.position; // The point on the path that we should target with PID.
-
-    point prev_position = chassis.odom.position;
+  desired_target = { "follow_path", true, (float)path.back().x, (float)path.back().y, false, 0 };
+
+  // Profiled paths are resampled once up front, and every point gets the velocity the robot should have there.
+  std::vector<path_point> profiled_path = {};
+  if (p.profiled) {
+    profiled_path = profile_path(path, p.spacing, p.max_velocity, p.max_acceleration, p.max_lateral_acceleration);
+    path.clear();
+    for (const path_point& pp : profiled_path) {
+      path.push_back(pp.position);
+    }
+  }
 
-    // Loop through all waypoints in the provided path.
-    for (int i = 0; i < (path.size() - 1); i++) {
-      point start = path[i]; // The current waypoint
-      point end = path[i+1]; // The next waypoint
+  point target_intersection = start_position; // The point on the path that we should target with PID.
+  point prev_position = start_position;
+  pursuit_lookahead lookahead; // Cursor into the path, only searches a few segments ahead each tick.
+  size_t closest = 0; // Index of the profiled point closest to the robot.
   
-      while (dist(chassis.odom.position, end) > p.lookahead_distance) {
-        // Find the point(s) of intersection between a circle centered around our global position with the radius of our
-        // lookahead distance and a line segment formed between our starting/ending points.
-        // This can be 0-2 points depending on whether there are tangent, secant, or no intersections.
-        std::vector<point> intersections = line_circle_intersections(chassis.odom.position, p.lookahead_distance, start, end);
+  start_motion({
+    [this, pid, pid_2, path, profiled_path, p, target_intersection, prev_position, lookahead, closest]() mutable {
+      pose current = frame.odom_pose;
+      point current_position = { current.x, current.y };
+
+      // Find the furthest point along the path where a circle centered around our global position with the
+      // radius of our lookahead distance crosses the path, ensuring that we don't go backwards along the path.
+      // If the circle doesn't cross the path we keep heading for the last target.
+      lookahead.find(path, current_position, p.lookahead_distance, target_intersection);
+      if (lookahead.is_finished(path, current_position, p.lookahead_distance)) { return false; }
+
+      distance_traveled += dist(current_position, prev_position);
+      prev_position = current_position;
   
-        // Choose the best intersection to go to, ensuring that we don't go backwards along the path.
-        if (intersections.size() == 2) {
-          // There are two intersections between our lookahead circle and the path. Find the one closest to the end of the line segment.
-          if (dist(intersections[0], end) < dist(intersections[1], end)) {
-            target_intersection = intersections[0];
-          } else {
-            target_intersection = intersections[1];
-          }
-        } else if (intersections.size() == 1) {
-          // There is one intersection. Go to that intersection.
-          target_intersection = intersections[0];
+      // Move towards the target intersection with PID
+      float drive_error = dist(current_position, target_intersection);
+
+      float heading_error = frame.rotation.error_to(to_deg(atan2(target_intersection.x - current_position.x, target_intersection.y - current_position.y)));
+      float drive_output = 0;
+      if (p.profiled) {
+        // The closest point only ever moves forward, so the robot can't be pulled back to an earlier part of the path.
+        while (closest < profiled_path.size() - 1 && dist(current_position, profiled_path[closest+1].position) <= dist(current_position, profiled_path[closest].position)) {
+          closest++;
         }
-
-        point current_position = chassis.odom.position;
-        chassis.distance_traveled += dist(current_position, prev_position);
-        prev_position = current_position;
-  
-        // Move towards the target intersection with PID
-        float drive_error = dist(chassis.odom.position, target_intersection);
-
-        float heading_error = reduce_negative_180_to_180(to_deg(atan2(target_intersection.x - chassis.odom.position.x, target_intersection.y - chassis.odom.position.y)) - chassis.get_absolute_heading());
-        float drive_output = chassis.pid.compute(drive_error);
+        // Use the point ahead of the closest one, otherwise the robot would be asked to stay at rest on the first point.
+        const path_point& target = profiled_path[std::min(closest + 1, profiled_path.size() - 1)];
+        drive_output = drive_feedforward.compute(target.velocity, target.acceleration, (frame.left_velocity + frame.right_velocity) / 2);
+      } else {
+        drive_output = pid.compute(drive_error, executor.dt);
+      }
   
-        float heading_scale_factor = cos(to_rad(heading_error));
-        drive_output *= heading_scale_factor;
-        heading_error = reduce_negative_90_to_90(heading_error);
-        float heading_output = chassis.pid_2.compute(heading_error);
-        
-        if (drive_error < p.settle_error) { heading_output = 0; }
+      float heading_scale_factor = cos(to_rad(heading_error));
+      drive_output *= heading_scale_factor;
+      heading_error = reduce_negative_90_to_90(heading_error);
+      float heading_output = pid_2.compute(heading_error, executor.dt);
+      
+      if (drive_error < p.settle_error) { heading_output = 0; }
   
-        drive_output = clamp(drive_output, -fabs(heading_scale_factor) * p.max_voltage, fabs(heading_scale_factor) * p.max_voltage);
-        heading_output = clamp(heading_output, -p.heading_max_voltage, p.heading_max_voltage);
+      drive_output = clamp(drive_output, -fabs(heading_scale_factor) * p.max_voltage, fabs(heading_scale_factor) * p.max_voltage);
+      heading_output = clamp(heading_output, -p.heading_max_voltage, p.heading_max_voltage);
   
-        chassis.drive_with_voltage(drive_output + heading_output, drive_output - heading_output);
-        task::sleep(10);
-      }
+      drive_with_slew(drive_output + heading_output, drive_output - heading_output, p.slew_accelerate, p.slew_decelerate);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
     }
+  });
+  
+  if (p.wait) { this->wait(); }
+}
+
+template <size_t N>
+inline void Chassis::follow_path(const std::array<point, N>& path, const follow_path_params& p) {
+  follow_path(std::vector<point>(path.begin(), path.end()), p);
+}
+
+template <size_t N>
+inline void Chassis::follow_path(const std::array<point, N>& path) {
+  follow_path(path, follow_path_params{});
+}
+
+inline void Chassis::follow_trajectory(std::vector<trajectory_point> trajectory, const follow_trajectory_params& p = follow_trajectory_params{}) {
+  if (trajectory.empty()) { return; }
+  preempt_motion();
+
+  for (auto& sample : trajectory) {
+    sample.position.x = mirror_x(sample.position.x, x_pos_mirrored_);
+    sample.position.y = mirror_y(sample.position.y, y_pos_mirrored_);
+    sample.heading = mirror_angle(sample.heading, angles_mirrored_);
+    if (angles_mirrored_) { sample.angular_velocity = -sample.angular_velocity; }
+  }
 
-    chassis.motion_running = false;
-    if (p.min_voltage == 0) { chassis.stop_drive(hold); }
+  desired_path.clear();
+  for (const auto& sample : trajectory) {
+    desired_path.push_back(sample.position);
+  }
+  desired_target = { "follow_trajectory", true, (float)trajectory.back().position.x, (float)trajectory.back().position.y, true, trajectory.back().heading };
 
-    return 0;
+  motion_running = true;
+  distance_traveled = 0;
+
+  float elapsed_time = 0;
+  size_t index = 0;
+  pose start = get_pose();
+  point prev_position = { start.x, start.y };
+
+  start_motion({
+    [this, trajectory, p, elapsed_time, index, prev_position]() mutable {
+      elapsed_time += executor.dt / 1000;
+      if (elapsed_time > trajectory.back().time) { return false; }
+
+      trajectory_point target = sample_trajectory(trajectory, elapsed_time, index);
+      desired_X_position = target.position.x;
+      desired_Y_position = target.position.y;
+      desired_heading = target.heading;
+
+      pose current = frame.odom_pose;
+      point current_position = { current.x, current.y };
+      distance_traveled += dist(current_position, prev_position);
+      prev_position = current_position;
+
+      // Pose error in the robot's frame, forward and to the left, with counter-clockwise positive angles.
+      float heading = to_rad(current.theta);
+      float error_x = target.position.x - current_position.x;
+      float error_y = target.position.y - current_position.y;
+      float forward_error = error_x * sin(heading) + error_y * cos(heading);
+      float left_error = error_y * sin(heading) - error_x * cos(heading);
+      float heading_error = -to_rad(reduce_negative_180_to_180(target.heading - current.theta));
+
+      float desired_velocity = target.velocity;
+      float desired_angular_velocity = -to_rad(target.angular_velocity);
+
+      float k = 2 * p.zeta * sqrt(desired_angular_velocity * desired_angular_velocity + p.b * desired_velocity * desired_velocity);
+      float sinc = fabs(heading_error) < 1e-4 ? 1 : sin(heading_error) / heading_error;
+      float velocity = desired_velocity * cos(heading_error) + k * forward_error;
+      float angular_velocity = desired_angular_velocity + k * heading_error + p.b * desired_velocity * sinc * left_error;
+
+      // Back to clockwise positive, turning clockwise speeds up the left side.
+      float wheel_offset = -angular_velocity * drive_track_width / 2;
+      drive_with_velocity(velocity + wheel_offset, velocity - wheel_offset, target.acceleration, target.acceleration, p.max_voltage);
+      return true;
+    },
+    [this, p](){
+      if (!executor.is_handing_off()) { motion_running = false; }
+      if (p.min_voltage == 0 && !executor.is_handing_off()) { stop_drive(hold); }
+    }
   });
-  
+
   if (p.wait) { this->wait(); }
+}
+
+inline void Chassis::queue_drive_distance(float distance, drive_distance_params p = drive_distance_params{}, float exit_velocity = 0) {
+  if (exit_velocity > 0) { p.min_voltage = std::max(p.min_voltage, drive_feedforward.compute(exit_velocity, 0)); }
+  p.wait = false;
+  queue_motion("drive_distance", [this, distance, p](){ drive_distance(distance, p); });
+}
+
+inline void Chassis::queue_turn_to_angle(float angle, turn_to_angle_params p = turn_to_angle_params{}, float exit_velocity = 0) {
+  if (exit_velocity > 0) { p.min_voltage = std::max(p.min_voltage, turn_feedforward.compute(exit_velocity, 0)); }
+  p.wait = false;
+  queue_motion("turn_to_angle", [this, angle, p](){ turn_to_angle(angle, p); });
+}
+
+inline void Chassis::queue_drive_to_point(float X_position, float Y_position, drive_to_point_params p = drive_to_point_params{}, float exit_velocity = 0) {
+  if (exit_velocity > 0) { p.min_voltage = std::max(p.min_voltage, drive_feedforward.compute(exit_velocity, 0)); }
+  p.wait = false;
+  queue_motion("drive_to_point", [this, X_position, Y_position, p](){ drive_to_point(X_position, Y_position, p); });
+}
+
+inline void Chassis::queue_drive_to_pose(float X_position, float Y_position, float angle, drive_to_pose_params p = drive_to_pose_params{}, float exit_velocity = 0) {
+  if (exit_velocity > 0) { p.min_voltage = std::max(p.min_voltage, drive_feedforward.compute(exit_velocity, 0)); }
+  p.wait = false;
+  queue_motion("drive_to_pose", [this, X_position, Y_position, angle, p](){ drive_to_pose(X_position, Y_position, angle, p); });
+}
+
+inline void Chassis::queue_follow_path(std::vector<point> path, follow_path_params p = follow_path_params{}, float exit_velocity = 0) {
+  if (exit_velocity > 0) { p.min_voltage = std::max(p.min_voltage, drive_feedforward.compute(exit_velocity, 0)); }
+  p.wait = false;
+  queue_motion("follow_path", [this, path, p](){ follow_path(path, p); });
 }
\ No newline at end of file
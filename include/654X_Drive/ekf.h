@@ -0,0 +1,71 @@
+#pragma once
+
+#include "vex.h"
+
+/** @brief Raw odometry inputs from one odom tick, logged so runs can be replayed. */
+struct odom_sample {
+    uint32_t timestamp = 0; // vex::timer::system() in milliseconds.
+    float forward_tracker = 0; // Forward tracker position in inches.
+    float sideways_tracker = 0; // Sideways tracker position in inches.
+    float left_drive = 0; // Left drive wheel position in inches.
+    float right_drive = 0; // Right drive wheel position in inches.
+    float heading = 0; // Inertial heading in degrees.
+    float heading_rate = 0; // Inertial rate in degrees per second, clockwise positive.
+    float distances[4] = {}; // Localization distance sensor readings in inches, 0 when not in use.
+};
+
+/**
+ * @brief Extended Kalman filter estimating x, y and heading.
+ * Every tick the filter predicts with the tracker deltas, cross-checked against the
+ * drive encoder deltas, and the gyro rate. It then corrects heading with the absolute
+ * inertial heading.
+ * The forward distance is an inverse-variance blend of the tracker and the drive encoders.
+ * When the two disagree by more than the gate, one of them has lost the ground.
+ * A tracker that reads almost nothing while the drive moves has lifted, and the drive is
+ * used. Otherwise the drive wheels are slipping, and the tracker is used.
+ * Units are inches and degrees, the state is kept in radians.
+ */
+class pose_ekf {
+public:
+    pose_ekf();
+
+    /**
+     * @param ForwardTracker_center_distance Horizontal distance from the center of the robot to the forward tracker in inches.
+     * @param SidewaysTracker_center_distance Vertical distance from the center of the robot to the sideways tracker in inches.
+     */
+    void set_physical_distances(float ForwardTracker_center_distance, float SidewaysTracker_center_distance);
+
+    /**
+     * @brief Resets the estimate to a known pose with small uncertainty.
+     * @param position Field-centric x and y position of the robot.
+     * @param orientation_deg Field-centered, clockwise-positive, orientation.
+     * @param sample Current sensor readings, later deltas are measured from these.
+     */
+    void set_position(point position, float orientation_deg, const odom_sample& sample);
+
+    /**
+     * @brief Runs one predict and correct step.
+     * @param sample Current sensor readings.
+     */
+    void update(const odom_sample& sample);
+
+    /** @return Estimated orientation in degrees (0-360). */
+    float get_orientation_deg();
+
+    point position;
+    float covariance[3][3] = {}; // Over x (in), y (in) and heading (rad).
+    int rejected_ticks = 0; // Ticks where the tracker and the drive encoders disagreed.
+
+    float tracker_noise = .02; // Tracker error per inch travelled.
+    float drive_noise = .08; // Drive encoder error per inch travelled, larger because of scrub.
+    float gyro_noise = .02; // Gyro error per radian turned.
+    float gyro_rate_noise = .0005; // Gyro error per tick when still, in radians.
+    float heading_noise = .01; // Standard deviation of the absolute inertial heading in radians.
+    float gate = 3; // Standard deviations the tracker and drive can differ by before one is rejected.
+
+private:
+    float ForwardTracker_center_distance = 0;
+    float SidewaysTracker_center_distance = 0;
+    float heading_rad = 0;
+    odom_sample last;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vex.h"
+
+/**
+ * @brief Maps a desired velocity and acceleration to voltage.
+ * kS covers friction and is applied in the direction of travel, kV covers
+ * back EMF and kA covers the torque needed to speed up. An optional kP term
+ * corrects for the difference between desired and measured velocity, so
+ * the position controllers on top of it can stay gentle.
+ */
+class feedforward {
+public:
+    feedforward();
+
+    /**
+     * @param ks Volts needed to overcome static friction.
+     * @param kv Volts per unit of velocity.
+     * @param ka Volts per unit of acceleration.
+     * @param kp Volts per unit of velocity error, 0 to disable feedback.
+     */
+    feedforward(float ks, float kv, float ka, float kp = 0);
+
+    /**
+     * @brief Feedforward only.
+     * @param velocity Desired velocity.
+     * @param acceleration Desired acceleration.
+     * @return Output voltage.
+     */
+    float compute(float velocity, float acceleration);
+
+    /**
+     * @brief Feedforward with velocity feedback.
+     * @param velocity Desired velocity.
+     * @param acceleration Desired acceleration.
+     * @param measured_velocity Velocity the mechanism is actually moving at.
+     * @return Output voltage.
+     */
+    float compute(float velocity, float acceleration, float measured_velocity);
+
+    float ks = 0;
+    float kv = 0;
+    float ka = 0;
+    float kp = 0;
+};
+
+/** @brief One logged sample from a characterization run. */
+struct feedforward_sample {
+    float voltage = 0;
+    float velocity = 0;
+    float acceleration = 0; // Change in velocity until the next sample, divided by dt.
+};
+
+/**
+ * @brief Fits kS, kV and kA to logged samples with least squares.
+ * The model is voltage = kS * sign(velocity) + kV * velocity + kA * acceleration,
+ * fit in its discrete form so noisy acceleration doesn't bias kA towards 0.
+ * Samples where the mechanism is barely moving are skipped since static
+ * friction there doesn't follow the model.
+ *
+ * @param samples Logged voltage, velocity and acceleration.
+ * @param min_velocity Samples slower than this are ignored.
+ * @param dt Time between samples in seconds.
+ * @param result ks, kv and ka are written here, kp is left alone.
+ * @return R squared of the fit, or -1 if the data couldn't be fit.
+ */
+float fit_feedforward(const std::vector<feedforward_sample>& samples, float min_velocity, float dt, feedforward& result);
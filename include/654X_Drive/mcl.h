@@ -0,0 +1,122 @@
+#pragma once
+
+#include "vex.h"
+
+/** @brief A straight wall the distance sensors can see. */
+struct wall_segment {
+    point start;
+    point end;
+};
+
+/** @brief Where a distance sensor is mounted, relative to the center of the robot. */
+struct distance_beam {
+    float x_offset = 0; // Inches, positive is to the right.
+    float y_offset = 0; // Inches, positive is forwards.
+    float angle = 0; // Degrees the sensor faces from forwards, clockwise positive.
+};
+
+/**
+ * @brief Monte Carlo localization against the field walls.
+ * A fixed pool of particles, each a guess at the robot's pose, is moved by the odom
+ * deltas with some noise. Particles are then weighted by how well the distance they
+ * would see to the nearest wall matches each sensor, and resampled towards the good
+ * ones. Nothing is allocated after construction, and the cost of an update is
+ * particles * beams * walls ray tests, so the budget per tick is set by the particle count.
+ * No vex calls are made, so logs can be replayed through it anywhere the code builds.
+ */
+class particle_filter {
+public:
+    static constexpr int max_particles = 500;
+    static constexpr int max_beams = 4;
+    static constexpr int max_walls = 16;
+
+    /** @brief Starts with the four walls of a 144 inch field centered on (0, 0). */
+    particle_filter();
+
+    /**
+     * @brief Replaces the wall map.
+     * @param walls Walls in field coordinates.
+     * @param count Number of walls, at most max_walls.
+     */
+    void set_walls(const wall_segment* walls, int count);
+
+    /**
+     * @brief Adds a distance sensor. Readings passed to update() are in the order beams were added.
+     * @return False if max_beams are already in use.
+     */
+    bool add_beam(const distance_beam& beam);
+
+    /** @return Number of beams added. */
+    int get_beam_count();
+
+    /**
+     * @brief Sets how many particles are used, trading accuracy for time per update.
+     * @param count Particles, clamped to 1-max_particles.
+     */
+    void set_particle_count(int count);
+
+    /**
+     * @brief Scatters the particles around a known pose.
+     * @param position Field-centric x and y position of the robot.
+     * @param orientation_deg Field-centered, clockwise-positive, orientation.
+     * @param spread Standard deviation of the scatter in inches.
+     */
+    void reset(point position, float orientation_deg, float spread = 1);
+
+    /**
+     * @brief Moves every particle by an odometry delta with added noise.
+     * @param forward Distance travelled forwards at the center of the robot in inches.
+     * @param sideways Distance travelled to the right at the center of the robot in inches.
+     * @param orientation_deg Inertial heading after the move, trusted apart from a little noise.
+     */
+    void predict(float forward, float sideways, float orientation_deg);
+
+    /**
+     * @brief Weights the particles by the distance readings and resamples when the weights get uneven.
+     * @param distances One reading per beam in inches. Readings <= 0 or past max_range are skipped.
+     * @return False if no reading was usable.
+     */
+    bool update(const float* distances);
+
+    /** @return Weighted mean pose of the particles. */
+    pose estimate();
+
+    /** @return Standard deviation of the particle positions in inches, lower is more certain. */
+    float get_spread();
+
+    float max_range = 78; // Readings further than this are ignored, in inches.
+    float sensor_noise = 1; // Standard deviation of a reading in inches.
+    float sensor_noise_scale = .03; // Extra standard deviation per inch of reading.
+    float outlier_probability = .05; // Chance a reading hits something other than a wall.
+    float motion_noise = .05; // Standard deviation per inch travelled.
+    float heading_noise = 1; // Standard deviation of the heading each particle uses, in degrees.
+
+private:
+    struct particle {
+        float x = 0;
+        float y = 0;
+        float heading = 0;
+        float weight = 0;
+    };
+
+    /** @return Distance from origin along angle_deg to the nearest wall, or max_range if none is hit. */
+    float ray_cast(float x, float y, float angle_deg);
+
+    /** @brief Systematic resampling, copies through the scratch pool. */
+    void resample();
+
+    /** @return Uniform random number in [0, 1). */
+    float uniform();
+
+    /** @return Approximately normal random number with a standard deviation of 1. */
+    float gaussian();
+
+    std::array<particle, max_particles> particles = {};
+    std::array<particle, max_particles> scratch = {};
+    std::array<wall_segment, max_walls> walls = {};
+    std::array<distance_beam, max_beams> beams = {};
+    int particle_count = 200;
+    int wall_count = 0;
+    int beam_count = 0;
+    uint32_t random_state = 0x654;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "vex.h"
+
+/**
+ * @brief A motion handed to the motion executor.
+ * update() is called once every control tick and returns true while the
+ * motion still has work to do. exit() is called once, on the control
+ * thread, after update() returns false.
+ */
+struct motion {
+    std::function<bool()> update = nullptr;
+    std::function<void()> exit = nullptr;
+};
+
+/**
+ * @brief Flag any thread can raise to ask the control thread to stop a motion.
+ * Only the control thread acts on it, at the start of a tick, so a motion is
+ * never stopped partway through an update or a motor command.
+ */
+class cancellation_token {
+public:
+    /** @brief Asks for the running motion to be stopped. */
+    void request();
+
+    /** @return True once requested, until cleared. */
+    bool is_requested();
+
+    /** @brief Called by the control thread once the request has been handled. */
+    void clear();
+
+private:
+    std::atomic<bool> requested{false};
+};
+
+/**
+ * @brief Long-lived control thread that runs motions at a fixed period.
+ * Replaces spawning a vex::task for every motion. Motions are swapped in at
+ * tick boundaries so a motion is never interrupted halfway through a tick,
+ * and every motion shares the same loop timing and jitter measurements.
+ */
+class motion_executor {
+public:
+    /** @param period_ms Control loop period in milliseconds. */
+    motion_executor(int period_ms = 10);
+
+    /** @brief Starts the control thread, does nothing if it is already running. */
+    void init();
+
+    /**
+     * @brief Hands a motion to the control thread. It replaces the running motion,
+     * if any, on the next tick, after the running motion's exit() is called as a hand off.
+     * @param new_motion The motion to run.
+     */
+    void start(motion new_motion);
+
+    /**
+     * @brief Drops any queued motion and requests the running motion be stopped.
+     * The control thread calls its exit() at the start of the next tick, so the
+     * motion's state is never left halfway through an update.
+     * @param hand_off True if another motion is about to take over, see is_handing_off().
+     */
+    void cancel(bool hand_off = false);
+
+    /**
+     * @brief Yields until no motion is queued or running.
+     * Returns right away when called from the control thread, which would otherwise wait on itself.
+     * @param timeout Time to wait in milliseconds.
+     * @return True if the executor is idle.
+     */
+    bool wait_until_idle(int timeout = 100);
+
+    /** @return True while a motion is queued or running. */
+    bool is_running();
+
+    /**
+     * @return True while a motion's exit() is being called because another motion is taking
+     * over. Exits should leave the drive moving so the next motion starts from the current speed.
+     */
+    bool is_handing_off();
+
+    /** @return True if the caller is running on the control thread, e.g. from an update() or a trigger. */
+    bool on_control_thread();
+
+    /** @brief Resets the loop timing statistics. */
+    void reset_loop_stats();
+
+    /**
+     * @brief Takes the lock the control thread runs each tick under, which start() and cancel() also take.
+     * No motion can start, stop or be cancelled until unlock_motions(). Must not be called from the control thread.
+     */
+    void lock_motions();
+
+    /** @brief Releases the lock taken by lock_motions(). */
+    void unlock_motions();
+
+    int period_ms; // Control loop period in milliseconds.
+    std::function<void()> on_tick = nullptr; // Called at the start of every tick that runs a motion, before update().
+    std::function<void(uint32_t)> on_finish = nullptr; // Called after a motion's exit() with how long it ran in milliseconds.
+    std::function<bool(motion&)> next_motion = nullptr; // Asked for a motion whenever none is running, so queued motions take over on the tick the last one finished.
+
+    /** LOOP TIMING, UPDATED EVERY TICK */
+
+    float dt = 0; // Measured time since the previous tick in milliseconds.
+    float max_jitter = 0; // Largest difference between dt and period_ms in milliseconds.
+    float average_jitter = 0; // Running average difference between dt and period_ms in milliseconds.
+    int overruns = 0; // Number of ticks that took longer than period_ms to run.
+    int ticks = 0; // Number of ticks since the stats were reset.
+
+    cancellation_token cancellation; // Raised by cancel(), checked by the control thread at the start of every tick.
+
+private:
+    void control_loop();
+
+    /** @brief Calls the running motion's exit() and on_finish, must hold the lock. */
+    void finish_motion(bool hand_off);
+
+    // The flags are read from other threads by is_running() and on_control_thread() without the lock.
+    motion current_motion;
+    motion queued_motion;
+    std::atomic<bool> motion_queued{false};
+    std::atomic<bool> motion_active{false};
+    uint32_t motion_start_time = 0;
+    bool hand_off_requested = false;
+    std::atomic<bool> handing_off{false};
+    std::atomic<int32_t> control_thread_id{-1};
+
+    std::atomic<bool> task_started{false};
+    vex::mutex lock;
+    vex::task control_task;
+};
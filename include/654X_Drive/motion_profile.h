@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vex.h"
+
+/** @brief Position, velocity and acceleration the profile wants at one instant. */
+struct profile_point {
+    float position = 0;
+    float velocity = 0; // Units per second.
+    float acceleration = 0; // Units per second squared.
+};
+
+/**
+ * @brief Time-parameterized S-curve motion profile over a straight distance.
+ * The profile is built from seven constant-jerk phases: jerk up, constant
+ * acceleration, jerk down, cruise, and the mirror of those while slowing.
+ * A max_jerk of 0 collapses the jerk phases and gives a trapezoidal profile.
+ * If the distance is too short to reach max_velocity the peak velocity is
+ * lowered so the profile still starts and ends at rest.
+ * Units are whatever distance is given in (inches or degrees) and seconds.
+ */
+class motion_profile {
+public:
+    motion_profile();
+
+    /**
+     * @param distance Signed distance to travel.
+     * @param max_velocity Max velocity in units per second.
+     * @param max_acceleration Max acceleration in units per second squared.
+     * @param max_jerk Max jerk in units per second cubed. Using 0 gives a trapezoidal profile.
+     */
+    motion_profile(float distance, float max_velocity, float max_acceleration, float max_jerk = 0);
+
+    /**
+     * @brief Samples the profile.
+     * Times before 0 or after the end hold the start or end of the profile.
+     *
+     * @param time Seconds since the start of the profile.
+     * @return The setpoint at that time.
+     */
+    profile_point sample(float time);
+
+    /** @return Total duration of the profile in seconds. */
+    float get_duration();
+
+private:
+    /** @brief One constant-jerk section of the profile and the state it starts from. */
+    struct phase {
+        float duration = 0;
+        float position = 0;
+        float velocity = 0;
+        float acceleration = 0;
+        float jerk = 0;
+    };
+
+    /**
+     * @brief Finds the jerk and constant-acceleration durations needed to go from rest to velocity.
+     * @return Distance covered while speeding up.
+     */
+    float speed_up_distance(float velocity, float& jerk_time, float& accel_time, float& peak_acceleration);
+
+    float direction_sign = 1;
+    float distance = 0;
+    float max_acceleration = 0;
+    float max_jerk = 0;
+    float duration = 0;
+    phase phases[7];
+};
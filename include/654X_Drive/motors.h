@@ -174,6 +174,20 @@ public:
      */
     float position(vex::rotationUnits units);
     
+    /** 
+     * @brief Gets the current velocity of the first motor in the group.
+     * @return Returns a float that represents the current velocity of the motor in the units defined in the parameter.
+     * @param units The measurement unit for the velocity.
+     */
+    float velocity(vex::velocityUnits units);
+
+    /** 
+     * @brief Gets the current average velocity of the motors in the group.
+     * @return Returns a float that represents the current velocity of the motors in the units defined in the parameter.
+     * @param units The measurement unit for the velocity.
+     */
+    float averageVelocity(vex::velocityUnits units);
+
     /** 
      * @brief Gets the current voltage of the first motor in the group.
      * @return Returns a float that represents the current voltage of the motor in the units defined in the parameter.
@@ -283,13 +297,40 @@ public:
      * @return The wrapped vex motors in a vector
      */   
     std::vector<mik::motor>& getMotors();
+
+    /** 
+     * @brief Scales every voltage the motor group spins with by nominal / battery voltage, so
+     * outputs tuned on a full battery act the same as it sags. Off by default.
+     * @param enabled True to compensate.
+     * @param nominal_voltage Battery voltage in volts the outputs were tuned at.
+     */
+    void setVoltageCompensation(bool enabled, float nominal_voltage = 12.6);
+
+    /** 
+     * @return The ratio the last spin was scaled by, 1 when compensation is off.
+     */
+    float compensationRatio(void);
     
     
 private:
     float to_volt(float voltage, vex::voltageUnits velocityUnits);
+
+    /** @return The voltage in volts scaled for the battery and clamped to 12, when compensation is on. */
+    float compensate(float voltage);
     
     float set_voltage = 6; 
 
+    bool compensation_enabled = false;
+    float nominal_voltage = 12.6;
+    float compensation_ratio = 1;
+
     std::vector<mik::motor> motors;
 };
+
+/** 
+ * @brief Battery voltage, low-pass filtered so brief current spikes don't move every output.
+ * Shared by every motor group that compensates for battery sag.
+ * @return Filtered battery voltage in volts.
+ */
+float filtered_battery_voltage(void);
 }
\ No newline at end of file
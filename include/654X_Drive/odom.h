@@ -41,6 +41,9 @@ class odom
    * All the deltas are done by getting member variables and comparing them to 
    * the input. Ultimately this all works to update the public member variable
    * X_position. This function needs to be run at 200Hz or so for best results.
+   * The arc's chord is rotated straight into field coordinates by the heading halfway
+   * through the update, with one sine/cosine evaluation for the half angle and one for
+   * the rotation, and a series in place of the half angle's sine when barely turning.
    * 
    * @param ForwardTracker_position Current position of the sensor in inches.
    * @param SidewaysTracker_position Current position of the sensor in inches.
@@ -48,6 +51,41 @@ class odom
    */
   void update_position(float ForwardTracker_position, float SidewaysTracker_position, float orientation_deg);
 
+  /**
+   * The original form of update_position(), converting the local displacement to polar
+   * coordinates and back. Kept so the faster version can be checked against it, and
+   * wraps the heading change across 0/360 the same way so only the math differs.
+   * 
+   * @param ForwardTracker_position Current position of the sensor in inches.
+   * @param SidewaysTracker_position Current position of the sensor in inches.
+   * @param orientation_deg Field-centered, clockwise-positive, orientation.
+   */
+  void update_position_polar(float ForwardTracker_position, float SidewaysTracker_position, float orientation_deg);
+
+  /**
+   * Resets the position for precision mode, where trackers are read as whole
+   * encoder ticks so no rounding builds up in their running totals.
+   * 
+   * @param position Field-centric x and y position of the robot.
+   * @param orientation_deg Field-centered, clockwise-positive, orientation.
+   * @param ForwardTracker_ticks Current position of the sensor in ticks.
+   * @param SidewaysTracker_ticks Current position of the sensor in ticks.
+   * @param ForwardTracker_inch_per_tick Inches the forward wheel travels per tick.
+   * @param SidewaysTracker_inch_per_tick Inches the sideways wheel travels per tick.
+   */
+  void set_position_ticks(point position, double orientation_deg, int32_t ForwardTracker_ticks, int32_t SidewaysTracker_ticks, double ForwardTracker_inch_per_tick, double SidewaysTracker_inch_per_tick);
+
+  /**
+   * Precision mode version of update_position(). Tracker deltas are exact integer
+   * differences, all the math is in double, and position is accumulated with Kahan
+   * summation so the rounding of thousands of small additions doesn't drift a long run.
+   * 
+   * @param ForwardTracker_ticks Current position of the sensor in ticks.
+   * @param SidewaysTracker_ticks Current position of the sensor in ticks.
+   * @param orientation_deg Field-centered, clockwise-positive, orientation.
+   */
+  void update_position_ticks(int32_t ForwardTracker_ticks, int32_t SidewaysTracker_ticks, double orientation_deg);
+
   point position;
   float orientation_deg; 
 
@@ -56,4 +94,11 @@ private:
   float SidewaysTracker_center_distance;
   float ForwardTracker_position;
   float SideWaysTracker_position;
+
+  int32_t ForwardTracker_ticks = 0;
+  int32_t SidewaysTracker_ticks = 0;
+  double ForwardTracker_inch_per_tick = 0;
+  double SidewaysTracker_inch_per_tick = 0;
+  double precise_orientation_deg = 0;
+  point compensation = {0, 0}; // Low-order bits lost from position by Kahan summation.
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "vex.h"
+
+/** @brief A resampled path point with the speed the follower should have there. */
+struct path_point {
+    point position;
+    float distance = 0; // Distance along the path from the first point in inches.
+    float curvature = 0; // 1 / turning radius in 1/inches, 0 on straights.
+    float velocity = 0; // Target velocity in inches per second.
+    float acceleration = 0; // Target acceleration in inches per second squared, towards the next point.
+};
+
+/**
+ * @brief Resamples a path so points are evenly spaced.
+ * Waypoints that sit on top of each other are dropped, and the
+ * last waypoint is always kept.
+ *
+ * @param path Waypoints to resample.
+ * @param spacing Distance between points in inches.
+ * @return Evenly spaced points along the same line segments.
+ */
+std::vector<point> resample_path(const std::vector<point>& path, float spacing);
+
+/**
+ * @brief Curvature of the circle through three points.
+ * @return 1 / radius in 1/inches, 0 if the points are in a line.
+ */
+float path_curvature(point p1, point p2, point p3);
+
+/**
+ * @brief Runs once when a path is handed to the follower. Resamples the path,
+ * finds the curvature at each point, and assigns every point a velocity.
+ * Velocity is capped by max_velocity and by the speed at which the robot would
+ * need more than max_lateral_acceleration to hold the curve. A backwards pass then
+ * makes the robot slow down in time for tight curves and stop at the end, and a
+ * forwards pass limits how quickly it speeds up from rest.
+ *
+ * @param path Waypoints to follow.
+ * @param spacing Distance between resampled points in inches.
+ * @param max_velocity Max velocity in inches per second.
+ * @param max_acceleration Max acceleration in inches per second squared.
+ * @param max_lateral_acceleration Max acceleration towards the center of a curve in inches per second squared.
+ * @return The resampled path with distance, curvature, velocity and acceleration filled in.
+ */
+std::vector<path_point> profile_path(const std::vector<point>& path, float spacing, float max_velocity, float max_acceleration, float max_lateral_acceleration);
+
+/**
+ * @brief Allocation-free version of line_circle_intersections() for use every control tick.
+ * Solves for where p1 + t * (p2 - p1) is radius away from center, keeping 0 <= t <= 1.
+ *
+ * @param center Center of the circle.
+ * @param radius Radius of the circle.
+ * @param p1 Start of the line segment.
+ * @param p2 End of the line segment.
+ * @param out Filled with the intersections, ordered from p1 to p2.
+ * @param out_t Optional, filled with how far along the segment each intersection is (0 to 1).
+ * @return Number of intersections written to out (0-2).
+ */
+int line_circle_intersections(point center, float radius, point p1, point p2, point out[2], float out_t[2] = nullptr);
+
+/**
+ * @brief Incremental lookahead search for pure pursuit.
+ * Keeps a cursor on the path segment it last targeted and only searches a bounded
+ * window of segments ahead of it, so per-tick cost doesn't grow with path length
+ * and the target can jump ahead past short segments. The target never moves back
+ * along the path.
+ */
+class pursuit_lookahead {
+public:
+    /** @param window Number of segments searched ahead of the cursor each tick. */
+    pursuit_lookahead(int window = 8);
+
+    /** @brief Puts the cursor back on the first segment. */
+    void reset();
+
+    /**
+     * @brief Finds the point on the path the robot should drive towards.
+     * If the lookahead circle doesn't touch the searched window, target is left unchanged.
+     *
+     * @param path Path being followed.
+     * @param position Robot position.
+     * @param radius Lookahead distance in inches.
+     * @param target The furthest intersection along the path, updated in place.
+     * @return True if an intersection was found.
+     */
+    bool find(const std::vector<point>& path, point position, float radius, point& target);
+
+    /** @return True once the cursor is on the last segment and its end is within radius of position. */
+    bool is_finished(const std::vector<point>& path, point position, float radius);
+
+    int window;
+    size_t segment = 0; // Index of the waypoint at the start of the segment the target is on.
+    float segment_t = 0; // How far along that segment the target is (0 to 1).
+};
+
+/** @brief One time-indexed sample of a trajectory. */
+struct trajectory_point {
+    float time = 0; // Seconds from the start of the trajectory.
+    point position;
+    float heading = 0; // Field-centered, clockwise-positive, orientation in degrees.
+    float velocity = 0; // Inches per second.
+    float acceleration = 0; // Inches per second squared.
+    float angular_velocity = 0; // Degrees per second, clockwise positive.
+};
+
+/**
+ * @brief Turns a path into a trajectory the robot can follow in time.
+ * The path is profiled with profile_path(), then each point gets the time the robot
+ * should reach it, the heading of the path there, and the rate the heading changes.
+ *
+ * @param path Waypoints to follow.
+ * @param spacing Distance between resampled points in inches.
+ * @param max_velocity Max velocity in inches per second.
+ * @param max_acceleration Max acceleration in inches per second squared.
+ * @param max_lateral_acceleration Max acceleration towards the center of a curve in inches per second squared.
+ * @return Trajectory samples in time order.
+ */
+std::vector<trajectory_point> generate_trajectory(const std::vector<point>& path, float spacing, float max_velocity, float max_acceleration, float max_lateral_acceleration);
+
+/**
+ * @brief Linearly interpolates a trajectory at a time.
+ * Times before the start or after the end hold the first or last sample.
+ *
+ * @param trajectory Trajectory samples in time order.
+ * @param time Seconds from the start of the trajectory.
+ * @param index Search hint, the index of the sample at or before time. Updated in place.
+ * @return The interpolated sample.
+ */
+trajectory_point sample_trajectory(const std::vector<trajectory_point>& trajectory, float time, size_t& index);
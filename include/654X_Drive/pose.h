@@ -0,0 +1,83 @@
+#pragma once
+
+#include "vex.h"
+
+/** @brief Snapshot of where the robot is, published by the odom task. */
+struct pose {
+    float x = 0; // Inches.
+    float y = 0; // Inches.
+    float theta = 0; // Field-centered, clockwise-positive, orientation in degrees.
+    uint32_t timestamp = 0; // vex::timer::system() in milliseconds when the pose was published.
+    uint32_t seq = 0; // Increases every time a pose is published.
+};
+
+/**
+ * @brief Sequence lock around a pose so one writer can publish while any number of
+ * readers copy it out without locks. The sequence is odd while a write is in progress,
+ * and readers retry if it was odd or changed while they were copying, so they never
+ * see x from one update and y from another.
+ */
+class pose_seqlock {
+public:
+    /**
+     * @brief Publishes a new pose. Only one task may publish.
+     * @param x X position in inches.
+     * @param y Y position in inches.
+     * @param theta Orientation in degrees.
+     * @param timestamp Time the pose was measured in milliseconds.
+     */
+    void publish(float x, float y, float theta, uint32_t timestamp);
+
+    /** @return A consistent copy of the last published pose. */
+    pose read() const;
+
+private:
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<float> x{0};
+    std::atomic<float> y{0};
+    std::atomic<float> theta{0};
+    std::atomic<uint32_t> timestamp{0};
+};
+
+/**
+ * @brief Fixed-size ring buffer of timestamped poses, so a sensor reading taken a few
+ * ticks ago can be matched with where the robot was when it was taken.
+ * At the odom rate of 5 ms the buffer holds the last ~640 ms.
+ */
+class pose_history {
+public:
+    static constexpr size_t capacity = 128;
+
+    /**
+     * @brief Adds a pose. Timestamps must not go backwards, a pose older
+     * than the newest one is dropped.
+     */
+    void push(const pose& p);
+
+    /** @brief Forgets every pose, used when the robot's coordinates are reset. */
+    void clear();
+
+    /**
+     * @brief Finds where the robot was at a past time.
+     * The two poses either side of the time are found with a binary search, position is
+     * interpolated linearly, and heading is interpolated along the shorter way around.
+     * Times newer than the newest pose hold the newest pose.
+     *
+     * @param timestamp Time in milliseconds, same clock as vex::timer::system().
+     * @param result Filled with the interpolated pose.
+     * @return False if the buffer is empty or the time is older than the oldest pose.
+     */
+    bool sample(uint32_t timestamp, pose& result);
+
+    /** @return Number of poses stored. */
+    size_t size();
+
+private:
+    /** @brief The i-th oldest stored pose. */
+    const pose& at(size_t i) const;
+
+    std::array<pose, capacity> poses = {};
+    size_t head = 0; // Index the next pose is written to.
+    size_t count = 0;
+    vex::mutex lock;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "vex.h"
+
+/**
+ * @brief Every chassis sensor reading a controller needs, captured once at the start of a
+ * control tick. Motions read from the frame instead of the devices, so each tick makes one
+ * smart port read per value and every controller in it sees the same numbers.
+ */
+struct sensor_frame {
+    uint32_t timestamp = 0; // vex::timer::system() in milliseconds when the frame was captured.
+    unwrapped_heading rotation; // Inertial heading in degrees, continuous across full turns.
+    float heading = 0; // Inertial heading in degrees (0-360).
+    float heading_rate = 0; // Inertial rate in degrees per second, clockwise positive.
+    float forward_tracker = 0; // Forward tracker position in inches.
+    float sideways_tracker = 0; // Sideways tracker position in inches.
+    float left_velocity = 0; // Left drive wheel velocity in inches per second.
+    float right_velocity = 0; // Right drive wheel velocity in inches per second.
+    float left_current = 0; // Left drive current in amps.
+    float right_current = 0; // Right drive current in amps.
+    pose odom_pose; // Latest odom pose.
+};
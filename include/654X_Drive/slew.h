@@ -0,0 +1,35 @@
+#pragma once
+
+#include "vex.h"
+
+/**
+ * @brief Limits how fast an output can change, with separate limits for speeding up and
+ * slowing down. Speeding up is any change that moves the output away from 0, slowing down
+ * is any change towards it. An output that changes sign slows down to 0 first.
+ */
+class slew_limiter {
+public:
+    /**
+     * @param accelerate_rate Largest increase in magnitude per second, 0 for no limit.
+     * @param decelerate_rate Largest decrease in magnitude per second, 0 for no limit.
+     */
+    slew_limiter(float accelerate_rate = 0, float decelerate_rate = 0);
+
+    /**
+     * @brief Moves the output towards the target by at most the limit for dt.
+     * @param target Requested output.
+     * @param dt Time since the last call in milliseconds.
+     * @return Limited output.
+     */
+    float limit(float target, float dt);
+
+    /**
+     * @brief Sets the output the next limit() starts from, like after the output was set elsewhere.
+     * @param output Current output.
+     */
+    void reset(float output = 0);
+
+    float accelerate_rate = 0;
+    float decelerate_rate = 0;
+    float output = 0; // Last output returned by limit(), or set by reset().
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "vex.h"
+
+// Compile-time path generation. Everything here is constexpr so a path written as a
+// handful of control points is turned into evenly spaced points by the compiler, e.g.
+//
+//   constexpr point waypoints[] = { {0, 0}, {0, 12}, {12, 24}, {24, 24} };
+//   constexpr auto path = catmull_rom_path<40>(waypoints);
+//   chassis.follow_path(path);
+
+/** @brief One cubic Bezier segment, starts at p0 and ends at p3. */
+struct cubic_segment {
+    point p0 = {0, 0};
+    point p1 = {0, 0};
+    point p2 = {0, 0};
+    point p3 = {0, 0};
+};
+
+/** @brief Newton's method square root that can run at compile time. */
+constexpr double constexpr_sqrt(double x) {
+  if (x <= 0) { return 0; }
+  double guess = x > 1 ? x : 1;
+  for (int i = 0; i < 64; i++) {
+    double next = (guess + x / guess) / 2;
+    if (next == guess) { break; }
+    guess = next;
+  }
+  return guess;
+}
+
+/** @brief Point on a cubic Bezier segment at 0 <= t <= 1. */
+constexpr point cubic_segment_point(const cubic_segment& segment, double t) {
+  double u = 1 - t;
+  double a = u * u * u;
+  double b = 3 * u * u * t;
+  double c = 3 * u * t * t;
+  double d = t * t * t;
+  return {
+    a * segment.p0.x + b * segment.p1.x + c * segment.p2.x + d * segment.p3.x,
+    a * segment.p0.y + b * segment.p1.y + c * segment.p2.y + d * segment.p3.y
+  };
+}
+
+template <size_t N>
+struct spline_samples {
+    point points[N] = {};
+};
+
+template <size_t N, size_t... I>
+constexpr std::array<point, N> spline_samples_to_array(const spline_samples<N>& samples, std::index_sequence<I...>) {
+  return {{ samples.points[I]... }};
+}
+
+/**
+ * @brief Samples a chain of cubic segments into N points evenly spaced by arc length.
+ * Arc length is found by walking each segment in small steps, so spacing is
+ * even to within a small fraction of an inch.
+ *
+ * @tparam N Number of points to generate, including both ends.
+ * @param segments Segments to sample, each starting where the last one ends.
+ * @param segment_count Number of segments.
+ * @return N points along the spline.
+ */
+template <size_t N>
+constexpr std::array<point, N> sample_spline(const cubic_segment* segments, size_t segment_count) {
+  static_assert(N >= 2, "A path needs at least two points");
+  constexpr int steps_per_segment = 64;
+
+  double total_length = 0;
+  for (size_t s = 0; s < segment_count; s++) {
+    point prev = segments[s].p0;
+    for (int k = 1; k <= steps_per_segment; k++) {
+      point next = cubic_segment_point(segments[s], (double)k / steps_per_segment);
+      total_length += constexpr_sqrt((next.x - prev.x) * (next.x - prev.x) + (next.y - prev.y) * (next.y - prev.y));
+      prev = next;
+    }
+  }
+
+  spline_samples<N> samples = {};
+  samples.points[0] = segments[0].p0;
+  size_t filled = 1;
+  double spacing = total_length / (N - 1);
+  double walked = 0;
+
+  for (size_t s = 0; s < segment_count; s++) {
+    point prev = segments[s].p0;
+    for (int k = 1; k <= steps_per_segment; k++) {
+      point next = cubic_segment_point(segments[s], (double)k / steps_per_segment);
+      double step = constexpr_sqrt((next.x - prev.x) * (next.x - prev.x) + (next.y - prev.y) * (next.y - prev.y));
+      // Place every sample that falls inside this step, interpolating between the step's ends.
+      while (filled < N - 1 && step > 0 && walked + step >= spacing * filled) {
+        double t = (spacing * filled - walked) / step;
+        samples.points[filled] = { prev.x + (next.x - prev.x) * t, prev.y + (next.y - prev.y) * t };
+        filled++;
+      }
+      walked += step;
+      prev = next;
+    }
+  }
+  samples.points[N - 1] = segments[segment_count - 1].p3;
+
+  return spline_samples_to_array(samples, std::make_index_sequence<N>{});
+}
+
+/**
+ * @brief Cubic Bezier path. Every three control points after the first make a segment,
+ * so there must be 3 * segments + 1 of them.
+ *
+ * @tparam N Number of points to generate.
+ * @param controls Start point, then two handles and an end point per segment.
+ * @return N points evenly spaced along the path.
+ */
+template <size_t N, size_t K>
+constexpr std::array<point, N> bezier_path(const point (&controls)[K]) {
+  static_assert(K >= 4 && (K - 1) % 3 == 0, "Bezier paths need 3 * segments + 1 control points");
+  cubic_segment segments[(K - 1) / 3] = {};
+  for (size_t s = 0; s < (K - 1) / 3; s++) {
+    segments[s] = { controls[3 * s], controls[3 * s + 1], controls[3 * s + 2], controls[3 * s + 3] };
+  }
+  return sample_spline<N>(segments, (K - 1) / 3);
+}
+
+/**
+ * @brief Cubic Hermite path through every waypoint with the given tangent at each one.
+ * Tangents are in inches, longer tangents make the path carry its direction further.
+ *
+ * @tparam N Number of points to generate.
+ * @param waypoints Points the path passes through.
+ * @param tangents Direction and strength of the path at each waypoint.
+ * @return N points evenly spaced along the path.
+ */
+template <size_t N, size_t K>
+constexpr std::array<point, N> hermite_path(const point (&waypoints)[K], const point (&tangents)[K]) {
+  static_assert(K >= 2, "Hermite paths need at least two waypoints");
+  cubic_segment segments[K - 1] = {};
+  for (size_t s = 0; s < K - 1; s++) {
+    segments[s] = {
+      waypoints[s],
+      { waypoints[s].x + tangents[s].x / 3, waypoints[s].y + tangents[s].y / 3 },
+      { waypoints[s+1].x - tangents[s+1].x / 3, waypoints[s+1].y - tangents[s+1].y / 3 },
+      waypoints[s+1]
+    };
+  }
+  return sample_spline<N>(segments, K - 1);
+}
+
+/**
+ * @brief Catmull-Rom path through every waypoint. Tangents are picked from the
+ * neighbouring waypoints, so only the points the robot should pass through are needed.
+ *
+ * @tparam N Number of points to generate.
+ * @param waypoints Points the path passes through.
+ * @return N points evenly spaced along the path.
+ */
+template <size_t N, size_t K>
+constexpr std::array<point, N> catmull_rom_path(const point (&waypoints)[K]) {
+  static_assert(K >= 2, "Catmull-Rom paths need at least two waypoints");
+  cubic_segment segments[K - 1] = {};
+  for (size_t s = 0; s < K - 1; s++) {
+    // The ends reuse their own waypoint as the missing neighbour.
+    point before = waypoints[s > 0 ? s - 1 : s];
+    point start = waypoints[s];
+    point end = waypoints[s+1];
+    point after = waypoints[s + 2 < K ? s + 2 : s + 1];
+    segments[s] = {
+      start,
+      { start.x + (end.x - before.x) / 6, start.y + (end.y - before.y) / 6 },
+      { end.x - (after.x - start.x) / 6, end.y - (after.y - start.y) / 6 },
+      end
+    };
+  }
+  return sample_spline<N>(segments, K - 1);
+}
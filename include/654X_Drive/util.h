@@ -75,8 +75,19 @@ float to_rad(float angle_deg);
  */
 float to_deg(float angle_rad);
 
+/**
+ * @brief Sine and cosine of one angle from a single range reduction.
+ * The angle is reduced to within 45 degrees of a multiple of 90, then short
+ * polynomials sharing the same square give both results. Accurate to about 1e-6.
+ * @param angle_rad The angle in radians, best kept within a few turns of 0.
+ * @param sin_out Set to the sine of the angle.
+ * @param cos_out Set to the cosine of the angle.
+ */
+void fast_sin_cos(float angle_rad, float& sin_out, float& cos_out);
+
 /**
  * @brief Converts an angle to an equivalent one in the range [-180, 180).
+ * Takes the same time however many turns the angle is from the range.
  * @param angle The angle to be reduced in degrees.
  * @return Reduced angle.
  */
@@ -85,7 +96,8 @@ float reduce_negative_180_to_180(float angle);
 /**
  * @brief Converts an angle to an equivalent one in the range [-90, 90).
  * If the angle has no equivalent, then the angle halfway around
- * the circle is returned.
+ * the circle is returned. Takes the same time however many turns the angle
+ * is from the range.
  * @param angle The angle to be reduced in degrees.
  * @return Reduced angle.
  */
@@ -93,6 +105,7 @@ float reduce_negative_90_to_90(float angle);
 
 /**
  * @brief Converts an angle to an equivalent one in the range [0, 360).
+ * Takes the same time however many turns the angle is from the range.
  * @param angle The angle to be reduced in degrees.
  * @return Reduced angle.
  */
@@ -142,10 +155,11 @@ float mirror_y(float y, bool mirror);
 /**
  * @brief Normalize an angular error according to a direction preference.
  *
- * For direction::CW, negative `error` values are wrapped by adding 360 so the
- * result is ≥ 0. For direction::CCW, positive `error` values are wrapped by
- * subtracting 360 so the result is ≤ 0. For direction::FASTEST (default), the
- * value is reduced to the range (-180, 180] via reduce_negative_180_to_180().
+ * For direction::CW, `error` is reduced to the range [0, 360) so the result
+ * is ≥ 0. For direction::CCW, it is reduced to the range (-360, 0] so the
+ * result is ≤ 0. For direction::FASTEST (default), the value is reduced to
+ * the range [-180, 180) via reduce_negative_180_to_180(). Any number of
+ * turns is taken off, so `error` may come from unwrapped headings.
  *
  * @param error Signed angular difference in degrees (e.g., target - current).
  * @param dir Direction preference: CW, CCW, or FASTEST (default).
@@ -153,6 +167,40 @@ float mirror_y(float y, bool mirror);
  */
 float angle_error(float error, direction dir = direction::FASTEST);
 
+/**
+ * @brief A heading kept as the continuous angle the inertial's rotation() reports.
+ * Nothing is wrapped as readings come in, so the angle turned between two readings
+ * is a subtraction, and an error to a target is wrapped once, in constant time.
+ */
+class unwrapped_heading {
+public:
+    /** @param degrees Continuous heading in degrees, clockwise positive. */
+    unwrapped_heading(float degrees = 0);
+
+    /** @return Continuous heading in degrees, clockwise positive. */
+    float unwrapped() const;
+
+    /** @return Heading in the range [0, 360). */
+    float wrapped() const;
+
+    /**
+     * @brief Error from this heading to a target, normalized by angle_error().
+     * @param target_deg Target heading in degrees, in any range.
+     * @param dir Direction preference: CW, CCW, or FASTEST (default).
+     * @return Signed error in degrees consistent with `dir`.
+     */
+    float error_to(float target_deg, direction dir = direction::FASTEST) const;
+
+    /**
+     * @param previous An earlier reading.
+     * @return Degrees turned since the earlier reading, clockwise positive, including full turns.
+     */
+    float turned_since(const unwrapped_heading& previous) const;
+
+private:
+    float degrees;
+};
+
 /**
  * @brief Settling control for odometry functions.
  * Draws a line perpendicular to the line from the robot to the desired 
@@ -149,4 +149,64 @@ void config_error_data();
 void config_skills_driver_run();
 
 /** @brief Triggers a component plugged into a 3 wire port at specified port */
-void config_test_three_wire_port(port port);
\ No newline at end of file
+void config_test_three_wire_port(port port);
+
+/** @brief Times one pure pursuit lookahead search per simulated tick on paths with hundreds of points.
+ * Compares the old per-segment search, which allocates a vector every tick, against pursuit_lookahead.
+ * Results are shown in the UI console in microseconds per tick.
+ */
+void config_benchmark_lookahead();
+
+/** @brief Measures drivetrain kS, kV and kA. Keep about 4 feet clear in front of and behind the robot.
+ * Runs slow voltage ramps and sudden voltage steps forwards and backwards, logging voltage, velocity
+ * and acceleration every 10 ms, then fits the constants with least squares. The results are applied,
+ * shown in the UI console, and saved to drive_feedforward.txt so default_constants() loads them at boot.
+ */
+void config_characterize_drive();
+
+/** @brief Compares arc odometry against the Kalman filter on a logged run, without moving the robot.
+ * Replays odom_log.txt from the SD card, recorded by config_record_odom_log(). Any run logged with
+ * start_odom_log() and save_odom_log() can be replayed by saving it as odom_log.txt. Runs that end where
+ * they started show each estimator's drift as its error from the start.
+ */
+void config_replay_odom_log();
+
+/** @brief Drives test_odom_full() while logging odometry, and saves it as odom_log.txt for config_replay_odom_log(). */
+void config_record_odom_log();
+
+/** @brief Runs test_full() with early settling on and shows how long each motion took and
+ * how much settle time early settling saved it in the UI console. Drive, turn and swing early
+ * settle conditions that are off are set to a conservative default for the run, and every early
+ * settle condition is put back afterwards.
+ */
+void config_settle_report();
+
+/** @brief Drives 24 inches out and back with and without the drive slew limit and shows the
+ * peak drive current and how far the drive encoders got ahead of the tracker in the UI console.
+ * Uses the chassis slew constants, or a moderate limit if they're still off.
+ */
+void config_compare_slew();
+
+/** @brief Drives the test_odom_full() route through the motion queue with motion chaining
+ * constants, blending between segments, and shows each segment's time and the total in the UI console.
+ */
+void config_test_motion_queue();
+
+/** @brief Checks odom::update_position() against the original polar form on a minute of synthetic driving.
+ * Both are fed the same tracker and heading readings, integrated exactly from a weaving path that
+ * crosses 0 degrees many times. Time per update, final error from the true path, and the largest
+ * difference between the two during the run are shown in the UI console.
+ */
+void config_benchmark_odom();
+
+/** @brief Compares odom drift with and without precision mode over a minute of synthetic forward driving.
+ * Both modes are fed the same whole encoder ticks and exact headings, and each one's distance from the
+ * true end position is shown in the UI console.
+ */
+void config_benchmark_odom_precision();
+
+/** @brief Times reduce_negative_180_to_180() against the loop version it replaced at a few distances from the range.
+ * The time per call is shown in the UI console. The results are checked against the loops on every float
+ * with sim/build/simulator --check-angles.
+ */
+void config_benchmark_angles();
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <utility>
 #include <math.h>
 #include <stdio.h>
 #include <cstdint>
@@ -29,7 +31,17 @@
 #include "654X_Drive/util.h"
 #include "654X_Drive/motors.h"
 #include "654X_Drive/odom.h"
+#include "654X_Drive/pose.h"
+#include "654X_Drive/ekf.h"
+#include "654X_Drive/mcl.h"
+#include "654X_Drive/sensor_frame.h"
 #include "654X_Drive/PID.h"
+#include "654X_Drive/feedforward.h"
+#include "654X_Drive/slew.h"
+#include "654X_Drive/motion_executor.h"
+#include "654X_Drive/motion_profile.h"
+#include "654X_Drive/path.h"
+#include "654X_Drive/spline.h"
 #include "654X_Drive/assembly.h"
 #include "654X_Drive/example_assembly.h"
 #include "654X_Drive/chassis.h"
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+/**
+ * Host simulator for the robot, behind the stand-in vex API in v5_vcs.h.
+ * A differential drive is modelled from motor torque curves, mass and inertia, wheel
+ * traction and a sagging battery, and stepped every millisecond of virtual time.
+ * Units are inches, degrees and seconds unless noted, headings are clockwise from +Y
+ * the same as the chassis.
+ */
+namespace sim {
+
+/** @brief Physical constants of the simulated robot. */
+struct robot_model {
+    float size = 18; // Width of the robot in inches, it stops against the field walls.
+    float mass = 6.8; // Kilograms.
+    float moment_of_inertia = .2; // Kilogram meters squared about the center.
+    float track_width = 12; // Distance between the left and right wheels in inches.
+    float wheel_diameter = 3.25; // Drive wheel diameter in inches.
+    float gear_ratio = .75; // Wheel rotations per motor rotation.
+
+    float free_speed = 600; // Drive motor speed with no load at 12 volts in rpm.
+    float stall_torque = .35; // Drive motor torque at the current limit in Nm.
+    float current_limit = 2.5; // Amps per motor, torque is proportional to current.
+
+    float traction = 1.1; // Friction coefficient between the wheels and the tiles, the wheels slip past this.
+    float wheel_inertia = .4; // Rotating mass of one side's wheels, gears and rotors, reflected to the tread in kilograms.
+    float rolling_resistance = 2; // Newtons per meter per second.
+    float turn_scrub = 1.2; // Nm resisting turning from wheels dragged sideways.
+
+    float battery_voltage = 12.8; // Open circuit voltage when full.
+    float battery_resistance = .12; // Internal resistance in ohms, what makes the voltage sag under load.
+    float battery_capacity = 1.1; // Amp hours, the open circuit voltage drops by a volt over the full charge.
+
+    float mechanism_free_speed = 200; // Motors not in the drive, speed with no load at 12 volts in rpm.
+    float mechanism_stall_torque = 2.1; // Motors not in the drive, torque at the current limit in Nm.
+    float mechanism_inertia = .002; // Load on motors not in the drive in kilogram meters squared.
+};
+
+/** @brief Where the robot really is, as opposed to where odometry thinks it is. */
+struct robot_state {
+    float x = 0;
+    float y = 0;
+    float heading = 0; // Unwrapped, so full turns accumulate.
+    float velocity = 0; // Forwards in inches per second.
+    float angular_velocity = 0; // Clockwise in degrees per second.
+    float left_slip = 0; // Left tread speed minus ground speed in inches per second.
+    float right_slip = 0;
+    bool against_wall = false; // Pushed into a field wall on the last step.
+};
+
+/** @brief Electrical readings over a run. */
+struct power_stats {
+    float battery_voltage = 0; // Terminal voltage in volts.
+    float total_current = 0; // Amps drawn by every motor.
+    float peak_current = 0; // Largest total_current since reset_power_stats().
+    float min_battery_voltage = 0; // Lowest battery_voltage since reset_power_stats().
+    float drive_energy = 0; // Joules delivered to the drive motors since reset_power_stats().
+};
+
+/** @return The model, edit before the run starts. */
+robot_model& model();
+
+/**
+ * @brief Marks motor ports as drive motors, the rest are modelled as mechanisms.
+ * @param left_ports Zero-based ports of the left side.
+ * @param right_ports Zero-based ports of the right side.
+ */
+void bind_drive(const std::vector<int>& left_ports, const std::vector<int>& right_ports);
+
+/**
+ * @brief Marks a rotation sensor as a tracking wheel.
+ * @param port Zero-based port.
+ * @param sideways True for a wheel that rolls sideways.
+ * @param diameter Wheel diameter in inches, negative if it reads backwards, as in robot-config.cpp.
+ * @param center_distance Offset from the center, as in robot-config.cpp.
+ */
+void bind_tracker(int port, bool sideways, float diameter, float center_distance);
+
+/**
+ * @brief Makes a rotation sensor read a mechanism motor's shaft.
+ * @param port Zero-based rotation sensor port.
+ * @param motor_port Zero-based motor port.
+ * @param ratio Sensor rotations per motor rotation.
+ */
+void bind_encoder(int port, int motor_port, float ratio);
+
+/**
+ * @brief Mounts a distance sensor, which then reads the distance to the field walls.
+ * @param port Zero-based port.
+ * @param x_offset Inches to the right of the center.
+ * @param y_offset Inches ahead of the center.
+ * @param angle Degrees the sensor faces from forwards, clockwise positive.
+ */
+void bind_distance(int port, float x_offset, float y_offset, float angle);
+
+/** @brief Moves the robot, at rest, without touching any sensor. */
+void set_pose(float x, float y, float heading);
+
+/** @return Where the robot really is. */
+robot_state get_state();
+
+/** @return Battery and current draw readings. */
+power_stats get_power_stats();
+void reset_power_stats();
+
+/**
+ * @brief Points the brain's SD card at a host directory.
+ * @param directory Directory files are read from and written to, empty for no card.
+ */
+void set_sd_card(const std::string& directory);
+
+/** @brief Drains the battery, e.g. to compare runs at the end of a match. */
+void set_battery_charge(float fraction);
+
+/** @return Milliseconds on the virtual clock. */
+uint32_t time_ms();
+
+/** @brief Steps the physics, called by the scheduler as the virtual clock moves. */
+void step_physics(uint64_t from_us, uint64_t to_us);
+
+/** SCHEDULER, USED BY THE VEX STAND-IN */
+
+/** @return Microseconds on the virtual clock. */
+uint64_t now_us();
+
+/** @return Id of the calling task, 0 for main(). */
+int32_t current_task();
+
+/** @return Id of a new task, which first runs when the caller next sleeps or yields. */
+int32_t start_task(std::function<int()> body);
+
+/** @brief Puts the calling task to sleep until a time on the virtual clock. */
+void sleep_until_us(uint64_t wake_us);
+
+/** @brief Lets every other task due now run before the caller continues. */
+void yield();
+
+/** @return False if the task had already finished or been stopped. */
+bool stop_task(int32_t id);
+bool suspend_task(int32_t id);
+bool resume_task(int32_t id);
+
+/** @brief Flushes output and exits without waiting on the tasks, which never end on their own. */
+[[noreturn]] void exit(int code);
+
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in for the VEX SDK's v5.h, see sim/include/v5_vcs.h.
+#include <cstdint>
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <functional>
+
+/**
+ * Host stand-in for the VEX SDK, only the parts this project uses.
+ * Devices are handles onto per-port state in the simulator (sim/include/sim.h), so copies
+ * of a device read and drive the same port, the same as on the brain. Tasks are threads
+ * that take turns on a virtual clock, which only moves when every task is asleep, so
+ * programs run as fast as the host allows and the same way every time.
+ */
+namespace vex {
+enum class directionType { fwd, rev, undefined };
+const directionType fwd = directionType::fwd;
+const directionType forward = directionType::fwd;
+const directionType reverse = directionType::rev;
+const directionType rev = directionType::rev;
+const directionType undefined = directionType::undefined;
+enum class brakeType { coast, brake, hold, undefined };
+const brakeType coast = brakeType::coast;
+const brakeType brake = brakeType::brake;
+const brakeType hold = brakeType::hold;
+enum class voltageUnits { volt, mV };
+const voltageUnits volt = voltageUnits::volt;
+enum class velocityUnits { pct, rpm, dps };
+const velocityUnits rpm = velocityUnits::rpm;
+const velocityUnits dps = velocityUnits::dps;
+enum class percentUnits { pct };
+const percentUnits pct = percentUnits::pct;
+const percentUnits percent = percentUnits::pct;
+enum class rotationUnits { deg, rev, raw };
+const rotationUnits deg = rotationUnits::deg;
+const rotationUnits degrees = rotationUnits::deg;
+const rotationUnits turns = rotationUnits::rev;
+enum class timeUnits { sec, msec };
+const timeUnits sec = timeUnits::sec;
+const timeUnits msec = timeUnits::msec;
+const timeUnits seconds = timeUnits::sec;
+enum class currentUnits { amp };
+const currentUnits amp = currentUnits::amp;
+enum class torqueUnits { Nm, InLb };
+const torqueUnits Nm = torqueUnits::Nm;
+enum class powerUnits { watt };
+const powerUnits watt = powerUnits::watt;
+enum class temperatureUnits { celsius, fahrenheit };
+const temperatureUnits celsius = temperatureUnits::celsius;
+enum class distanceUnits { mm, in, cm };
+const distanceUnits mm = distanceUnits::mm;
+const distanceUnits inches = distanceUnits::in;
+enum class analogUnits { pct };
+enum axisType { xaxis, yaxis, zaxis };
+enum controllerType { primary, partner };
+
+enum { PORT1 = 0, PORT2, PORT3, PORT4, PORT5, PORT6, PORT7, PORT8, PORT9, PORT10, PORT11,
+  PORT12, PORT13, PORT14, PORT15, PORT16, PORT17, PORT18, PORT19, PORT20, PORT21 };
+
+class color {
+public:
+    color() {}
+    color(uint32_t value) : value(value) {}
+    operator uint32_t() const { return value; }
+    static const color black, white, red, green, blue, yellow, orange, purple, cyan, transparent;
+private:
+    uint32_t value = 0;
+};
+extern const color black, white;
+
+/** @brief Time since the program started, or since clear(), on the virtual clock. */
+class timer {
+public:
+    timer();
+    double time(timeUnits units);
+    uint32_t time();
+    void clear();
+    static uint32_t system();
+    static uint64_t systemHighResolution();
+private:
+    uint64_t start_us = 0;
+};
+
+/** @brief Waiting tasks sleep rather than spin, so the task holding the lock gets to run. */
+class mutex {
+public:
+    void lock();
+    bool try_lock();
+    void unlock();
+private:
+    int32_t owner = -1;
+};
+
+class task {
+public:
+    task() {}
+    task(int (*callback)(void));
+    task(int (*callback)(void*), void* arg);
+    task(int (*callback)(void), int32_t priority);
+    bool stop();
+    bool suspend();
+    bool resume();
+    void setPriority(int32_t priority) {}
+    static void sleep(uint32_t time);
+    static void yield();
+private:
+    int32_t id = -1;
+};
+
+namespace this_thread {
+    void sleep_for(uint32_t time);
+    void sleep_until(uint32_t time);
+    void yield();
+    int32_t get_id();
+}
+void wait(double time, timeUnits units);
+
+class device {
+public:
+    device() {}
+    device(int32_t index) : index_(index) {}
+    int32_t index() { return index_; }
+    bool installed() { return true; }
+protected:
+    int32_t index_ = 0;
+};
+
+/**
+ * @brief Motors report the shaft from the robot's point of view, so the reversed flag
+ * only matters to how the motor is mounted and is otherwise transparent.
+ */
+class motor : public device {
+public:
+    motor(int32_t index);
+    motor(int32_t index, bool reverse);
+    void setStopping(brakeType mode);
+    void setVelocity(double velocity, velocityUnits units);
+    void setVelocity(double velocity, percentUnits units);
+    void resetPosition();
+    void setPosition(double value, rotationUnits units);
+    void setTimeout(int32_t time, timeUnits units);
+    void setMaxTorque(double value, percentUnits units);
+    void setMaxTorque(double value, torqueUnits units);
+    void setMaxTorque(double value, currentUnits units);
+    void spin(directionType dir);
+    void spin(directionType dir, double voltage, voltageUnits units);
+    void spin(directionType dir, double velocity, velocityUnits units);
+    bool spinFor(double rotation, rotationUnits units, double velocity, velocityUnits units_v, bool waitForCompletion = true);
+    bool spinFor(directionType dir, double rotation, rotationUnits units, double velocity, velocityUnits units_v, bool waitForCompletion = true);
+    bool spinFor(double rotation, rotationUnits units, bool waitForCompletion = true);
+    bool spinFor(directionType dir, double rotation, rotationUnits units, bool waitForCompletion = true);
+    bool isSpinning();
+    bool isDone();
+    void stop();
+    void stop(brakeType mode);
+    double position(rotationUnits units);
+    double velocity(velocityUnits units);
+    double velocity(percentUnits units);
+    double voltage(voltageUnits units = voltageUnits::volt);
+    double current(currentUnits units = currentUnits::amp);
+    double current(percentUnits units);
+    double power(powerUnits units = powerUnits::watt);
+    double torque(torqueUnits units = torqueUnits::Nm);
+    double efficiency(percentUnits units = percentUnits::pct);
+    double temperature(percentUnits units = percentUnits::pct);
+    double temperature(temperatureUnits units);
+private:
+    bool reversed = false;
+};
+
+class rotation : public device {
+public:
+    rotation(int32_t index, bool reverse = false);
+    double position(rotationUnits units);
+    double angle(rotationUnits units = rotationUnits::deg);
+    double velocity(velocityUnits units);
+    void resetPosition();
+    void setPosition(double value, rotationUnits units);
+private:
+    bool reversed = false;
+};
+
+class inertial : public device {
+public:
+    inertial(int32_t index) : device(index) {}
+    void calibrate();
+    bool isCalibrating();
+    double rotation(rotationUnits units = rotationUnits::deg);
+    double heading(rotationUnits units = rotationUnits::deg);
+    double gyroRate(axisType axis, velocityUnits units);
+    void setRotation(double value, rotationUnits units);
+    void setHeading(double value, rotationUnits units);
+};
+
+class distance : public device {
+public:
+    distance(int32_t index) : device(index) {}
+    double objectDistance(distanceUnits units);
+    bool isObjectDetected();
+};
+
+class optical : public device {
+public:
+    optical(int32_t index) : device(index) {}
+    double hue();
+    void setLightPower(double value, percentUnits units) {}
+};
+
+class triport {
+public:
+    class port {
+    public:
+        void set(bool value) { state = value; }
+        int32_t value() { return state; }
+    private:
+        bool state = false;
+    };
+    port Port[8];
+};
+
+class digital_out {
+public:
+    digital_out(triport::port& port) : port(&port) {}
+    void set(bool value) { port->set(value); }
+    int32_t value() { return port->value(); }
+private:
+    triport::port* port;
+};
+
+/** @brief The screen draws nothing. The SD card is a directory on the host, see sim::set_sd_card(). */
+class brain {
+public:
+    class lcd {
+    public:
+        void clearScreen() {}
+        void drawImageFromFile(const char* name, int x, int y) {}
+        void drawLine(int x1, int y1, int x2, int y2) {}
+        void drawRectangle(int x, int y, int width, int height) {}
+        int getStringHeight(const char* text) { return 0; }
+        int getStringWidth(const char* text) { return 0; }
+        bool pressing() { return false; }
+        void printAt(int x, int y, const char* format, ...) {}
+        void print(const char* format, ...) {}
+        bool render(bool vsync = false, bool run_scheduler = false) { return true; }
+        void setCursor(int row, int col) {}
+        void setFillColor(const color& fill) {}
+        void setPenColor(const color& pen) {}
+        void setPenWidth(uint32_t width) {}
+        int xPosition() { return 0; }
+        int yPosition() { return 0; }
+    };
+    class sdcard {
+    public:
+        bool isInserted();
+        bool exists(const char* name);
+        int32_t appendfile(const char* name, uint8_t* buffer, int32_t length);
+        int32_t loadfile(const char* name, uint8_t* buffer, int32_t length);
+        int32_t savefile(const char* name, uint8_t* buffer, int32_t length);
+        int32_t size(const char* name);
+    };
+    class battery {
+    public:
+        uint32_t capacity(percentUnits units = percentUnits::pct);
+        double voltage(voltageUnits units = voltageUnits::volt);
+        double current(currentUnits units = currentUnits::amp);
+    };
+    lcd Screen;
+    sdcard SDcard;
+    battery Battery;
+    timer Timer;
+    triport ThreeWirePort;
+};
+
+/** @brief Nothing is ever pressed. */
+class controller {
+public:
+    controller() {}
+    controller(controllerType type) {}
+    class axis {
+    public:
+        int32_t value() { return 0; }
+        int32_t position(percentUnits units = percentUnits::pct) { return 0; }
+    };
+    class button {
+    public:
+        bool pressing() { return false; }
+    };
+    class lcd {
+    public:
+        void clearScreen() {}
+        void setCursor(int32_t row, int32_t col) {}
+        template <typename T> void print(T value) {}
+        void clearLine(int32_t row) {}
+    };
+    axis Axis1, Axis2, Axis3, Axis4;
+    button ButtonL1, ButtonL2, ButtonR1, ButtonR2, ButtonUp, ButtonDown, ButtonLeft, ButtonRight, ButtonX, ButtonB, ButtonY, ButtonA;
+    lcd Screen;
+    void rumble(const char* pattern) {}
+};
+
+class competition {
+public:
+    void autonomous(void (*callback)(void)) { autonomous_callback = callback; }
+    void drivercontrol(void (*callback)(void)) { drivercontrol_callback = callback; }
+    void (*autonomous_callback)(void) = nullptr;
+    void (*drivercontrol_callback)(void) = nullptr;
+};
+}
+
+using namespace vex;
@@ -0,0 +1,105 @@
+#include "vex.h"
+#include "checks.h"
+#include <thread>
+
+namespace {
+
+float reduce_negative_180_to_180_loop(float angle) {
+  while(!(angle >= -180 && angle < 180)) {
+    if(angle < -180) { angle += 360; }
+    if(angle >= 180) { angle -= 360; }
+  }
+  return angle;
+}
+
+float reduce_negative_90_to_90_loop(float angle) {
+  while(!(angle >= -90 && angle < 90)) {
+    if(angle < -90) { angle += 180; }
+    if(angle >= 90) { angle -= 180; }
+  }
+  return angle;
+}
+
+float reduce_0_to_360_loop(float angle) {
+  while(!(angle >= 0 && angle < 360)) {
+    if(angle < 0) { angle += 360; }
+    if(angle >= 360) { angle -= 360; }
+  }
+  return angle;
+}
+
+/**
+ * @brief The exact equivalent of angle in [min, min + turn), worked out in double.
+ * Only used past 64 turns, where the remainder is a whole number of the angle's float steps
+ * below 360, so it's exact as a float too.
+ */
+float exact_reduction(float angle, double min, double turn) {
+  double reduced = fmod((double)angle, turn);
+  if (reduced < min) { reduced += turn; }
+  if (reduced >= min + turn) { reduced -= turn; }
+  return (float)reduced;
+}
+
+struct sweep_counts {
+  uint64_t against_loop = 0;
+  uint64_t against_exact = 0;
+  uint64_t non_finite = 0;
+  uint64_t failed = 0;
+};
+
+void sweep(uint32_t first, uint32_t step, sweep_counts& counts) {
+  const float loop_limit = 64 * 360;
+  for (uint64_t bits = first; bits <= UINT32_MAX; bits += step) {
+    uint32_t pattern = (uint32_t)bits;
+    float angle;
+    memcpy(&angle, &pattern, sizeof(angle));
+    float wrapped = reduce_0_to_360(angle);
+    float centered = reduce_negative_180_to_180(angle);
+    float half = reduce_negative_90_to_90(angle);
+
+    bool ok;
+    if (!std::isfinite(angle)) {
+      counts.non_finite++;
+      ok = std::isnan(wrapped) && std::isnan(centered) && std::isnan(half);
+    } else {
+      ok = wrapped >= 0 && wrapped < 360 && centered >= -180 && centered < 180 && half >= -90 && half < 90;
+      if (fabsf(angle) <= loop_limit) {
+        counts.against_loop++;
+        ok = ok && wrapped == reduce_0_to_360_loop(angle) && centered == reduce_negative_180_to_180_loop(angle) && half == reduce_negative_90_to_90_loop(angle);
+      } else {
+        counts.against_exact++;
+        ok = ok && wrapped == exact_reduction(angle, 0, 360) && centered == exact_reduction(angle, -180, 360) && half == exact_reduction(angle, -90, 180);
+      }
+    }
+    if (!ok) {
+      if (counts.failed < 5) { printf("  mismatch at %.9g: %.9g, %.9g, %.9g\n", angle, wrapped, centered, half); }
+      counts.failed++;
+    }
+  }
+}
+
+}
+
+uint64_t check_angle_reductions() {
+  printf("checking every float bit pattern against the loop reductions...\n");
+  fflush(stdout);
+  uint32_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<sweep_counts> counts(thread_count);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(sweep, i, thread_count, std::ref(counts[i]));
+  }
+  sweep_counts total;
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads[i].join();
+    total.against_loop += counts[i].against_loop;
+    total.against_exact += counts[i].against_exact;
+    total.non_finite += counts[i].non_finite;
+    total.failed += counts[i].failed;
+  }
+  printf("against the loops:   %llu\n", (unsigned long long)total.against_loop);
+  printf("against the exact:   %llu\n", (unsigned long long)total.against_exact);
+  printf("NaN and infinity:    %llu\n", (unsigned long long)total.non_finite);
+  printf("failed:              %llu\n", (unsigned long long)total.failed);
+  return total.failed;
+}
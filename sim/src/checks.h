@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Host-only checks of the robot code that are too slow or too data heavy to run on the brain,
+// run from sim/src/main.cpp.
+
+/**
+ * @brief Compares reduce_0_to_360(), reduce_negative_180_to_180() and reduce_negative_90_to_90()
+ * against the loop versions they replaced on every float bit pattern, and prints the counts.
+ * The loops take a step per turn, so past 64 turns the results are checked against the exact
+ * remainder instead. Every finite result has to land in range, and NaN and infinity, which
+ * the loops never returned from, have to come back as NaN. The sweep is split over every core,
+ * and takes about half an hour on one.
+ * @return Number of bit patterns that failed a check.
+ */
+uint64_t check_angle_reductions();
+
+/**
+ * @brief Runs a log saved by Chassis::save_odom_log() through Chassis::replay_odom_log(), the same
+ * as config_replay_odom_log() on the brain, and prints where each estimator ended up. A run that
+ * ends where it started shows each one's drift as its error from the start.
+ * @param file_path Log copied off the SD card.
+ * @param beams The distance sensors the log was recorded with as "x,y,angle", in the order they
+ * were added with add_localization_sensor(), so the particle filter runs on their readings.
+ * @return 0, or 1 if the log couldn't be read.
+ */
+int replay_log(const std::string& file_path, const std::vector<std::string>& beams);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "sim.h"
+#include "v5_vcs.h"
+
+// Per-port device state shared by the vex stand-in and the physics, private to the simulator.
+
+namespace sim {
+
+constexpr int port_count = 21;
+
+enum class motor_mode { VOLTAGE, VELOCITY, POSITION, STOPPED };
+
+struct motor_state {
+    motor_mode mode = motor_mode::STOPPED;
+    vex::brakeType stopping = vex::brakeType::coast; // Used by stop() and spin(dir) without a voltage.
+    vex::brakeType stopped_with = vex::brakeType::coast;
+    float command_voltage = 0; // VOLTAGE mode.
+    float target_velocity = 0; // VELOCITY and POSITION mode, in rpm.
+    double target_position = 0; // POSITION and hold, in degrees of shaft.
+    float velocity_setting = 100; // setVelocity(), rpm.
+    float max_torque_fraction = 1;
+    uint32_t timeout = 0; // Milliseconds, 0 for none.
+
+    bool drive = false; // Bound to a drive side, the shaft then follows the tread.
+    int side = 0; // 0 for left, 1 for right.
+
+    double shaft_position = 0; // Degrees, measured.
+    double position_offset = 0; // Subtracted from shaft_position by position().
+    float shaft_velocity = 0; // rpm.
+    float applied_voltage = 0; // Volts at the motor after the battery, what the controller asked for times the PWM.
+    float current = 0; // Amps.
+    float torque = 0; // Nm.
+    float temperature = 25; // Celsius.
+};
+
+struct rotation_state {
+    enum class source { NONE, FORWARD_TRACKER, SIDEWAYS_TRACKER, MOTOR } kind = source::NONE;
+    float diameter = 2;
+    float center_distance = 0;
+    int motor_port = -1;
+    float ratio = 1;
+
+    double travel = 0; // Inches rolled, for trackers.
+    double position_offset = 0; // Degrees.
+};
+
+struct inertial_state {
+    double offset = 0; // Added to the real heading by rotation().
+    uint64_t calibrated_at_us = 0;
+};
+
+struct distance_state {
+    bool mounted = false;
+    float x_offset = 0;
+    float y_offset = 0;
+    float angle = 0;
+};
+
+motor_state& motor_port(int port);
+rotation_state& rotation_port(int port);
+inertial_state& inertial_port(int port);
+distance_state& distance_port(int port);
+
+/** @return Degrees a rotation sensor has turned, before resetPosition() offsets. */
+double rotation_raw(int port);
+
+/** @return Inches from a mounted distance sensor to the nearest wall, or -1 past its range. */
+float distance_reading(int port);
+
+/** @return Host path of a file on the SD card, empty if no card is set. */
+std::string sd_path(const char* name);
+
+}
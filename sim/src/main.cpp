@@ -0,0 +1,253 @@
+#include "vex.h"
+#include "sim.h"
+#include "checks.h"
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs an auton from src/autons.cpp against the simulated robot, in place of src/main.cpp.
+// With --benchmark it runs every auton in turn and prints a CSV table of how each motion went,
+// so a change to the constants or a controller shows up as a diff between two tables.
+// --check-angles and --replay run the host checks in checks.h instead.
+
+namespace {
+
+struct auton_entry {
+  const char* name;
+  std::string (*run)(bool calibrate, auto_variation var, bool get_name, bool get_lineup);
+  uint32_t time_limit; // Milliseconds the auton gets in a match.
+};
+
+const auton_entry autons[] = {
+  { "template_auto", template_auto, 15000 },
+  { "blue_left_winpoint", blue_left_winpoint, 15000 },
+  { "blue_left_sawp", blue_left_sawp, 15000 },
+  { "blue_left_elim", blue_left_elim, 15000 },
+  { "blue_right_winpoint", blue_right_winpoint, 15000 },
+  { "blue_right_sawp", blue_right_sawp, 15000 },
+  { "blue_right_elim", blue_right_elim, 15000 },
+  { "red_left_winpoint", red_left_winpoint, 15000 },
+  { "red_left_sawp", red_left_sawp, 15000 },
+  { "red_left_elim", red_left_elim, 15000 },
+  { "red_right_winpoint", red_right_winpoint, 15000 },
+  { "red_right_sawp", red_right_sawp, 15000 },
+  { "red_right_elim", red_right_elim, 15000 },
+  { "skills", skills, 60000 },
+};
+
+/** @brief Tells the simulator how robot-config.cpp wired the robot. */
+void configure_robot() {
+  std::vector<int> left_ports, right_ports;
+  for (mik::motor& m : chassis.left_drive.getMotors()) { left_ports.push_back(m.index()); }
+  for (mik::motor& m : chassis.right_drive.getMotors()) { right_ports.push_back(m.index()); }
+  sim::bind_drive(left_ports, right_ports);
+
+  // The tracker diameters and center distances passed to the Chassis in robot-config.cpp.
+  sim::bind_tracker(chassis.forward_tracker.index(), false, -2, 0);
+  sim::bind_tracker(chassis.sideways_tracker.index(), true, 2, .3);
+
+  sim::bind_encoder(assembly.LB_encoder.index(), assembly.LB_motors.getMotors()[0].index(), 1.0 / 3);
+  sim::bind_encoder(assembly.intake_encoder.index(), assembly.intake_motor.index(), 1);
+  assembly.LB_encoder.setPosition(INACTIVE, deg);
+}
+
+const auton_entry* find_auton(const char* name) {
+  for (const auton_entry& entry : autons) {
+    if (strcmp(entry.name, name) == 0) { return &entry; }
+  }
+  return nullptr;
+}
+
+/** @brief One finished motion, or with motion -1 the whole auton. */
+struct motion_record {
+  int motion = -1;
+  motion_target target;
+  uint32_t start_time = 0; // Milliseconds since the match started.
+  uint32_t duration = 0;
+  float settle_time = 0; // How long the error had been inside settle_error when the motion ended.
+  float time_saved = 0; // Settle time early settling didn't wait out.
+  bool timed_out = false;
+  float peak_current = 0; // Amps drawn by every motor together.
+  sim::robot_state robot; // Where the robot really was when the motion ended.
+  pose odom; // Where odometry thought it was.
+};
+
+const auton_entry* running_auton = nullptr;
+auto_variation running_variation = auto_variation::ONE;
+bool auton_done = false;
+uint32_t match_start_time = 0;
+
+bool recording = false;
+std::vector<motion_record> records;
+motion_target ticked_target; // The running motion's target as of its last tick, a trigger may start the next before this one finishes.
+float motion_peak_current = 0;
+bool motion_open = false;
+
+/**
+ * @brief Records every motion from the control loop. The target is read each tick rather
+ * than at the finish, as a motion started from a trigger replaces it a tick before the
+ * motion it preempts finishes.
+ */
+void record_motions() {
+  std::function<void()> on_tick = chassis.executor.on_tick;
+  std::function<void(uint32_t)> on_finish = chassis.executor.on_finish;
+  chassis.executor.on_tick = [on_tick](){
+    if (on_tick) { on_tick(); }
+    if (!motion_open) {
+      motion_open = true;
+      motion_peak_current = 0;
+    }
+    ticked_target = chassis.desired_target;
+    motion_peak_current = std::max(motion_peak_current, sim::get_power_stats().total_current);
+  };
+  chassis.executor.on_finish = [on_finish](uint32_t duration){
+    if (on_finish) { on_finish(duration); }
+    motion_open = false;
+    if (!recording) { return; }
+    motion_record record;
+    record.motion = records.size();
+    record.target = ticked_target;
+    record.start_time = sim::time_ms() - duration - match_start_time;
+    record.duration = duration;
+    settle_report_entry settle = chassis.get_settle_report().back();
+    record.settle_time = settle.time_settled;
+    record.time_saved = settle.time_saved;
+    record.timed_out = settle.timed_out;
+    record.peak_current = motion_peak_current;
+    record.robot = sim::get_state();
+    record.odom = chassis.get_pose();
+    records.push_back(record);
+  };
+}
+
+void print_csv_header() {
+  printf("auton,variation,motion,name,start_ms,duration_ms,settle_ms,saved_ms,timed_out,peak_current_a,"
+    "target_x,target_y,target_heading,true_x,true_y,true_heading,position_error_in,heading_error_deg,odom_error_in\n");
+}
+
+/** @brief Unknown target coordinates are left empty. */
+void print_csv_row(const motion_record& record, const char* name) {
+  const motion_target& target = record.target;
+  const sim::robot_state& robot = record.robot;
+  printf("%s,%d,", running_auton->name, (int)running_variation);
+  if (record.motion < 0) { printf("total,"); } else { printf("%d,", record.motion + 1); }
+  printf("%s,%u,%u,%.0f,%.0f,%d,%.2f,", name, record.start_time, record.duration, record.settle_time, record.time_saved, record.timed_out, record.peak_current);
+  if (target.has_position) { printf("%.2f,%.2f,", target.X_position, target.Y_position); } else { printf(",,"); }
+  if (target.has_heading) { printf("%.2f,", reduce_0_to_360(target.heading)); } else { printf(","); }
+  printf("%.2f,%.2f,%.2f,", robot.x, robot.y, reduce_0_to_360(robot.heading));
+  if (target.has_position) { printf("%.2f,", hypot(robot.x - target.X_position, robot.y - target.Y_position)); } else { printf(","); }
+  if (target.has_heading) { printf("%.2f,", reduce_negative_180_to_180(robot.heading - target.heading)); } else { printf(","); }
+  printf("%.2f\n", hypot(robot.x - record.odom.x, robot.y - record.odom.y));
+}
+
+/** @brief Sets up the robot, runs the auton and either prints a summary or its CSV rows. */
+void run_auton(bool csv) {
+  configure_robot();
+  calibrate_inertial();
+  default_constants();
+  assembly.init_LB();
+  record_motions();
+
+  // Lineup moves happen before the match starts, so the clock starts after them.
+  running_auton->run(true, running_variation, false, false);
+  chassis.wait();
+  // The robot starts the match wherever odometry says it is.
+  float heading = chassis.get_absolute_heading();
+  sim::set_pose(chassis.get_X_position(), chassis.get_Y_position(), heading);
+  chassis.set_heading(heading);
+  sim::reset_power_stats();
+
+  match_start_time = sim::time_ms();
+  chassis.start_settle_report();
+  recording = true;
+  vex::task auton_task([](){
+    running_auton->run(false, running_variation, false, false);
+    auton_done = true;
+    return 0;
+  });
+  while (!auton_done && sim::time_ms() - match_start_time < running_auton->time_limit) {
+    task::sleep(10);
+  }
+  uint32_t runtime = sim::time_ms() - match_start_time;
+  chassis.stop_motion_task(auton_task);
+  recording = false;
+
+  sim::robot_state robot = sim::get_state();
+  sim::power_stats power = sim::get_power_stats();
+  if (csv) {
+    for (const motion_record& record : records) {
+      print_csv_row(record, record.target.name);
+    }
+    // The whole auton is judged against where the last motion was going.
+    motion_record total;
+    if (!records.empty()) { total.target = records.back().target; }
+    total.duration = runtime;
+    for (const motion_record& record : records) {
+      total.settle_time += record.settle_time;
+      total.time_saved += record.time_saved;
+      total.timed_out |= record.timed_out;
+    }
+    total.peak_current = power.peak_current;
+    total.robot = robot;
+    total.odom = chassis.get_pose();
+    print_csv_row(total, auton_done ? "done" : "out_of_time");
+    return;
+  }
+
+  printf("auton:       %s (variation %d)%s\n", running_auton->name, (int)running_variation, auton_done ? "" : ", ran out of time");
+  printf("runtime:     %.3f s\n", runtime / 1000.0);
+  printf("motions:     %d\n", (int)records.size());
+  printf("odom pose:   %.2f, %.2f, %.2f\n", chassis.get_X_position(), chassis.get_Y_position(), chassis.get_absolute_heading());
+  printf("true pose:   %.2f, %.2f, %.2f\n", robot.x, robot.y, reduce_0_to_360(robot.heading));
+  printf("peak current %.2f A, lowest battery %.2f V\n", power.peak_current, power.min_battery_voltage);
+}
+
+/**
+ * @brief Runs every auton in its own process, as the robot code keeps its state in globals,
+ * and prints their rows under one header.
+ * @return Number of autons whose process failed.
+ */
+int run_benchmark() {
+  print_csv_header();
+  fflush(stdout);
+  int failures = 0;
+  for (const auton_entry& entry : autons) {
+    pid_t child = fork();
+    if (child == 0) {
+      running_auton = &entry;
+      run_auton(true);
+      sim::exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (child < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      fprintf(stderr, "%s failed\n", entry.name);
+      failures++;
+    }
+  }
+  return failures;
+}
+
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1 && strcmp(argv[1], "--check-angles") == 0) {
+    sim::exit(check_angle_reductions() == 0 ? 0 : 1);
+  }
+  if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+    sim::exit(replay_log(argv[2], std::vector<std::string>(argv + 3, argv + argc)));
+  }
+  bool benchmark = argc > 1 && strcmp(argv[1], "--benchmark") == 0;
+  if (!benchmark && (argc < 2 || !find_auton(argv[1]))) {
+    printf("usage: %s <auton> [variation]\n       %s --benchmark [variation]\n       %s --check-angles\n       %s --replay <odom log> [x,y,angle of each distance sensor]\nautons:\n", argv[0], argv[0], argv[0], argv[0]);
+    for (const auton_entry& entry : autons) { printf("  %s\n", entry.name); }
+    sim::exit(argc < 2 ? 0 : 1);
+  }
+  running_variation = argc > 2 ? (auto_variation)atoi(argv[2]) : auto_variation::ONE;
+
+  if (benchmark) {
+    sim::exit(run_benchmark() == 0 ? 0 : 1);
+  }
+  running_auton = find_auton(argv[1]);
+  run_auton(false);
+  sim::exit(0);
+}
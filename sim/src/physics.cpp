@@ -0,0 +1,348 @@
+#include "devices.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace sim {
+
+namespace {
+
+constexpr float inch = .0254; // Meters per inch.
+constexpr float gravity = 9.81;
+constexpr float field_half_width = 72; // The walls of a 144 inch field centered on (0, 0).
+constexpr float distance_max_range = 78;
+
+robot_model robot;
+robot_state truth;
+power_stats power;
+
+motor_state motors[port_count];
+rotation_state rotations[port_count];
+inertial_state inertials[port_count];
+distance_state distances[port_count];
+
+struct side_state {
+  float tread = 0; // Tread speed in meters per second.
+  bool sliding = false;
+};
+side_state sides[2];
+float used_charge = 0; // Amp hours.
+float last_total_current = 0;
+std::string sd_directory;
+
+float sign(float x) { return x > 0 ? 1 : (x < 0 ? -1 : 0); }
+
+/** @return The voltage the motor's controller asks for, before the battery scales it. */
+float controller_voltage(motor_state& m, float free_speed, float dt) {
+  switch (m.mode) {
+    case motor_mode::VOLTAGE:
+      return m.command_voltage;
+    case motor_mode::POSITION: {
+      float error = m.target_position - m.shaft_position;
+      m.target_velocity = std::clamp(error * 4, -m.velocity_setting, m.velocity_setting);
+      return 12 * m.target_velocity / free_speed + .05 * (m.target_velocity - m.shaft_velocity);
+    }
+    case motor_mode::VELOCITY:
+      return 12 * m.target_velocity / free_speed + .05 * (m.target_velocity - m.shaft_velocity);
+    case motor_mode::STOPPED:
+      if (m.stopped_with == vex::brakeType::hold) {
+        return .4 * (m.target_position - m.shaft_position) - .02 * m.shaft_velocity;
+      }
+      return 0;
+  }
+  return 0;
+}
+
+/**
+ * @brief Torque from the motor's speed and the voltage across it, limited by the current limit.
+ * Coasting motors are open circuit. Braking shorts the windings, so the back EMF brakes the shaft.
+ */
+float motor_torque(motor_state& m, float terminal_voltage, float free_speed, float stall_torque, float dt) {
+  float speed_fraction = m.shaft_velocity / free_speed;
+  float limit = stall_torque * m.max_torque_fraction;
+  bool open = m.mode == motor_mode::STOPPED && m.stopped_with == vex::brakeType::coast;
+  if (open) {
+    m.applied_voltage = 0;
+    m.torque = 0;
+    m.current = 0;
+    return 0;
+  }
+  if (m.mode == motor_mode::STOPPED && m.stopped_with == vex::brakeType::brake) {
+    m.applied_voltage = 0;
+  } else {
+    m.applied_voltage = std::clamp(controller_voltage(m, free_speed, dt), -12.0f, 12.0f) * terminal_voltage / 12;
+  }
+  m.torque = std::clamp(stall_torque * (m.applied_voltage / 12 - speed_fraction), -limit, limit);
+  m.current = robot.current_limit * std::abs(m.torque) / stall_torque;
+  return m.torque;
+}
+
+void step(float dt) {
+  const float radius = robot.wheel_diameter / 2 * inch;
+  const float half_track = robot.track_width / 2 * inch;
+  const float drive_free_speed = robot.free_speed;
+  const float open_circuit = robot.battery_voltage - used_charge / robot.battery_capacity;
+  const float terminal_voltage = open_circuit - robot.battery_resistance * last_total_current;
+  float total_current = 0;
+
+  // Motor forces at the treads, and mechanisms, which only have their own load.
+  float tread_force[2] = { 0, 0 };
+  for (int port = 0; port < port_count; port++) {
+    motor_state& m = motors[port];
+    if (m.drive) {
+      float torque = motor_torque(m, terminal_voltage, drive_free_speed, robot.stall_torque, dt);
+      tread_force[m.side] += torque / robot.gear_ratio / radius;
+      power.drive_energy += std::abs(m.applied_voltage * m.current) * dt;
+    } else {
+      float torque = motor_torque(m, terminal_voltage, robot.mechanism_free_speed, robot.mechanism_stall_torque, dt);
+      float speed = m.shaft_velocity * 2 * M_PI / 60;
+      speed += (torque - .002 * speed) / robot.mechanism_inertia * dt;
+      m.shaft_velocity = speed * 60 / (2 * M_PI);
+      m.shaft_position += m.shaft_velocity * 6 * dt;
+    }
+    total_current += m.current;
+    m.temperature += (m.current * m.current * .4 - (m.temperature - 25) * .02) * dt;
+  }
+
+  // Ground forces, from keeping each gripping tread moving with the ground under it.
+  float velocity = truth.velocity * inch;
+  float angular_velocity = truth.angular_velocity * M_PI / 180;
+  float drag = robot.rolling_resistance * velocity;
+  float scrub = robot.turn_scrub * tanh(angular_velocity / .5);
+  float A = 1 / robot.mass;
+  float B = half_track * half_track / robot.moment_of_inertia;
+  float inv_tread = 1 / robot.wheel_inertia;
+  float diagonal = inv_tread + A + B;
+  float off_diagonal = A - B;
+  float rhs[2] = {
+    tread_force[0] * inv_tread + A * drag + half_track * scrub / robot.moment_of_inertia,
+    tread_force[1] * inv_tread + A * drag - half_track * scrub / robot.moment_of_inertia
+  };
+  float ground[2] = { 0, 0 };
+  float max_ground = robot.traction * robot.mass * gravity / 2;
+  float ground_speed[2] = { velocity + angular_velocity * half_track, velocity - angular_velocity * half_track };
+
+  for (int attempt = 0; attempt < 3; attempt++) {
+    for (int i = 0; i < 2; i++) {
+      if (sides[i].sliding) { ground[i] = max_ground * sign(sides[i].tread - ground_speed[i]); }
+    }
+    if (!sides[0].sliding && !sides[1].sliding) {
+      float determinant = diagonal * diagonal - off_diagonal * off_diagonal;
+      ground[0] = (rhs[0] * diagonal - rhs[1] * off_diagonal) / determinant;
+      ground[1] = (rhs[1] * diagonal - rhs[0] * off_diagonal) / determinant;
+    } else if (!sides[0].sliding) {
+      ground[0] = (rhs[0] - off_diagonal * ground[1]) / diagonal;
+    } else if (!sides[1].sliding) {
+      ground[1] = (rhs[1] - off_diagonal * ground[0]) / diagonal;
+    }
+
+    bool changed = false;
+    for (int i = 0; i < 2; i++) {
+      if (!sides[i].sliding && std::abs(ground[i]) > max_ground) {
+        sides[i].sliding = true;
+        // Starts sliding the way the tread is being pushed relative to the ground.
+        sides[i].tread = ground_speed[i] + sign(ground[i]) * 1e-4;
+        changed = true;
+      }
+    }
+    if (!changed) { break; }
+  }
+
+  float acceleration = (ground[0] + ground[1] - drag) * A;
+  float angular_acceleration = ((ground[0] - ground[1]) * half_track - scrub) / robot.moment_of_inertia;
+  velocity += acceleration * dt;
+  angular_velocity += angular_acceleration * dt;
+
+  for (int i = 0; i < 2; i++) {
+    float new_ground_speed = i == 0 ? velocity + angular_velocity * half_track : velocity - angular_velocity * half_track;
+    if (sides[i].sliding) {
+      float slip_before = sides[i].tread - ground_speed[i];
+      sides[i].tread += (tread_force[i] - ground[i]) * inv_tread * dt;
+      // Grips again once the tread catches up with the ground.
+      if (sign(sides[i].tread - new_ground_speed) != sign(slip_before)) {
+        sides[i].sliding = false;
+        sides[i].tread = new_ground_speed;
+      }
+    } else {
+      sides[i].tread = new_ground_speed;
+    }
+  }
+
+  // Move along the chord at the average heading over the step.
+  float heading_delta = angular_velocity * dt;
+  float mid = truth.heading * M_PI / 180 + heading_delta / 2;
+  truth.x += velocity * dt * sin(mid) / inch;
+  truth.y += velocity * dt * cos(mid) / inch;
+  truth.heading += heading_delta * 180 / M_PI;
+
+  // The walls stop the robot, treated as a circle size across, dead. The treads then stall against the carpet.
+  float limit = field_half_width - robot.size / 2;
+  float outward_x = truth.x > limit ? 1 : (truth.x < -limit ? -1 : 0);
+  float outward_y = truth.y > limit ? 1 : (truth.y < -limit ? -1 : 0);
+  truth.x = std::clamp(truth.x, -limit, limit);
+  truth.y = std::clamp(truth.y, -limit, limit);
+  truth.against_wall = (outward_x != 0 || outward_y != 0) && velocity * (outward_x * sin(mid) + outward_y * cos(mid)) > 0;
+  if (truth.against_wall) {
+    velocity = 0;
+    for (int i = 0; i < 2; i++) {
+      if (!sides[i].sliding) { sides[i].tread = i == 0 ? angular_velocity * half_track : -angular_velocity * half_track; }
+    }
+  }
+  truth.velocity = velocity / inch;
+  truth.angular_velocity = angular_velocity * 180 / M_PI;
+  truth.left_slip = (sides[0].tread - (velocity + angular_velocity * half_track)) / inch;
+  truth.right_slip = (sides[1].tread - (velocity - angular_velocity * half_track)) / inch;
+
+  for (int port = 0; port < port_count; port++) {
+    motor_state& m = motors[port];
+    if (!m.drive) { continue; }
+    float shaft_speed = sides[m.side].tread / radius / robot.gear_ratio;
+    m.shaft_velocity = shaft_speed * 60 / (2 * M_PI);
+    m.shaft_position += shaft_speed * 180 / M_PI * dt;
+  }
+  for (int port = 0; port < port_count; port++) {
+    rotation_state& r = rotations[port];
+    if (r.kind == rotation_state::source::FORWARD_TRACKER) {
+      r.travel += (velocity - angular_velocity * r.center_distance * inch) * dt / inch;
+    } else if (r.kind == rotation_state::source::SIDEWAYS_TRACKER) {
+      r.travel += -angular_velocity * r.center_distance * dt;
+    }
+  }
+
+  used_charge += total_current * dt / 3600;
+  last_total_current = total_current;
+  power.total_current = total_current;
+  power.battery_voltage = terminal_voltage;
+  power.peak_current = std::max(power.peak_current, total_current);
+  power.min_battery_voltage = power.min_battery_voltage > 0 ? std::min(power.min_battery_voltage, terminal_voltage) : terminal_voltage;
+}
+
+}
+
+robot_model& model() {
+  return robot;
+}
+
+motor_state& motor_port(int port) {
+  return motors[std::clamp(port, 0, port_count - 1)];
+}
+
+rotation_state& rotation_port(int port) {
+  return rotations[std::clamp(port, 0, port_count - 1)];
+}
+
+inertial_state& inertial_port(int port) {
+  return inertials[std::clamp(port, 0, port_count - 1)];
+}
+
+distance_state& distance_port(int port) {
+  return distances[std::clamp(port, 0, port_count - 1)];
+}
+
+void bind_drive(const std::vector<int>& left_ports, const std::vector<int>& right_ports) {
+  for (int port : left_ports) {
+    motor_port(port).drive = true;
+    motor_port(port).side = 0;
+  }
+  for (int port : right_ports) {
+    motor_port(port).drive = true;
+    motor_port(port).side = 1;
+  }
+}
+
+void bind_tracker(int port, bool sideways, float diameter, float center_distance) {
+  rotation_state& r = rotation_port(port);
+  r.kind = sideways ? rotation_state::source::SIDEWAYS_TRACKER : rotation_state::source::FORWARD_TRACKER;
+  r.diameter = diameter;
+  r.center_distance = center_distance;
+}
+
+void bind_encoder(int port, int motor_port, float ratio) {
+  rotation_state& r = rotation_port(port);
+  r.kind = rotation_state::source::MOTOR;
+  r.motor_port = motor_port;
+  r.ratio = ratio;
+}
+
+void bind_distance(int port, float x_offset, float y_offset, float angle) {
+  distance_port(port) = { true, x_offset, y_offset, angle };
+}
+
+double rotation_raw(int port) {
+  const rotation_state& r = rotation_port(port);
+  switch (r.kind) {
+    case rotation_state::source::FORWARD_TRACKER:
+    case rotation_state::source::SIDEWAYS_TRACKER:
+      return r.travel * 360 / (M_PI * r.diameter);
+    case rotation_state::source::MOTOR:
+      return motor_port(r.motor_port).shaft_position * r.ratio;
+    case rotation_state::source::NONE:
+      return 0;
+  }
+  return 0;
+}
+
+float distance_reading(int port) {
+  const distance_state& d = distance_port(port);
+  if (!d.mounted) { return -1; }
+  float heading = truth.heading * M_PI / 180;
+  float x = truth.x + d.x_offset * cos(heading) + d.y_offset * sin(heading);
+  float y = truth.y - d.x_offset * sin(heading) + d.y_offset * cos(heading);
+  float dx = sin(heading + d.angle * M_PI / 180);
+  float dy = cos(heading + d.angle * M_PI / 180);
+
+  // The walls are axis aligned, so the nearest hit is the nearest of the two walls ahead.
+  float nearest = distance_max_range;
+  if (dx > 1e-6) { nearest = std::min(nearest, (field_half_width - x) / dx); }
+  if (dx < -1e-6) { nearest = std::min(nearest, (-field_half_width - x) / dx); }
+  if (dy > 1e-6) { nearest = std::min(nearest, (field_half_width - y) / dy); }
+  if (dy < -1e-6) { nearest = std::min(nearest, (-field_half_width - y) / dy); }
+  return nearest >= distance_max_range ? -1 : std::max(nearest, 0.0f);
+}
+
+void set_pose(float x, float y, float heading) {
+  truth = robot_state();
+  truth.x = x;
+  truth.y = y;
+  truth.heading = heading;
+  sides[0] = side_state();
+  sides[1] = side_state();
+}
+
+robot_state get_state() {
+  return truth;
+}
+
+power_stats get_power_stats() {
+  return power;
+}
+
+void reset_power_stats() {
+  power.peak_current = power.total_current;
+  power.min_battery_voltage = power.battery_voltage;
+  power.drive_energy = 0;
+}
+
+void set_sd_card(const std::string& directory) {
+  sd_directory = directory;
+}
+
+std::string sd_path(const char* name) {
+  if (sd_directory.empty()) { return ""; }
+  return sd_directory + "/" + name;
+}
+
+void set_battery_charge(float fraction) {
+  used_charge = (1 - std::clamp(fraction, 0.0f, 1.0f)) * robot.battery_capacity;
+}
+
+void step_physics(uint64_t from_us, uint64_t to_us) {
+  // Fixed 1 ms steps, so results don't depend on how the tasks happen to sleep.
+  static uint64_t stepped_us = 0;
+  while (stepped_us + 1000 <= to_us) {
+    step(.001);
+    stepped_us += 1000;
+  }
+}
+
+}
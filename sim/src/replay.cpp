@@ -0,0 +1,44 @@
+#include "vex.h"
+#include "sim.h"
+#include "checks.h"
+
+namespace {
+
+void print_result(const char* name, const pose& result, const pose& start) {
+  printf("%-12s %8.2f, %8.2f, %7.2f   error from start %.2f in\n", name, result.x, result.y, result.theta, hypot(result.x - start.x, result.y - start.y));
+}
+
+}
+
+int replay_log(const std::string& file_path, const std::vector<std::string>& beams) {
+  default_constants();
+
+  // The readings come from the log, so the sensors only stand in for the beams, on ports
+  // robot-config.cpp leaves free.
+  const int32_t beam_ports[] = { PORT1, PORT2, PORT3, PORT7 };
+  for (size_t i = 0; i < beams.size(); i++) {
+    float x_offset, y_offset, angle;
+    if (i >= 4 || sscanf(beams[i].c_str(), "%f,%f,%f", &x_offset, &y_offset, &angle) != 3) {
+      fprintf(stderr, "bad beam %s, expected up to 4 of x,y,angle\n", beams[i].c_str());
+      return 1;
+    }
+    chassis.add_localization_sensor(*new vex::distance(beam_ports[i]), x_offset, y_offset, angle);
+  }
+
+  size_t slash = file_path.find_last_of('/');
+  sim::set_sd_card(slash == std::string::npos ? "." : file_path.substr(0, slash));
+  std::string file_name = slash == std::string::npos ? file_path : file_path.substr(slash + 1);
+
+  pose arc, ekf, mcl, start;
+  if (!chassis.replay_odom_log(file_name, arc, ekf, mcl, start)) {
+    fprintf(stderr, "couldn't read %s\n", file_path.c_str());
+    return 1;
+  }
+  printf("replayed %u samples\n", arc.seq);
+  printf("%-12s %8.2f, %8.2f, %7.2f\n", "start", start.x, start.y, start.theta);
+  print_result("arc", arc, start);
+  print_result("ekf", ekf, start);
+  // Without distance sensors the particle filter has nothing to correct arc odometry with.
+  if (!beams.empty()) { print_result("arc + walls", mcl, start); }
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include "sim.h"
+
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+
+// Every task is a host thread, but only the one holding the baton runs, the same as the
+// brain's cooperative scheduler. A task gives up the baton when it sleeps, and it goes to
+// whichever task is due soonest, moving the virtual clock forwards to its wake time.
+
+namespace sim {
+
+namespace {
+
+struct task_slot {
+  uint64_t wake_us = 0;
+  uint64_t order = 0; // Tasks due at the same time run in the order they went to sleep.
+  bool done = false;
+  bool suspended = false;
+  std::condition_variable baton;
+};
+
+struct scheduler {
+  std::mutex lock;
+  std::vector<std::unique_ptr<task_slot>> tasks;
+  int32_t running = 0;
+  uint64_t now = 0;
+  uint64_t order = 0;
+
+  scheduler() {
+    // main() is task 0 and starts with the baton.
+    tasks.push_back(std::make_unique<task_slot>());
+  }
+
+  /** @brief Hands the baton to the next task due, then waits for it to come back to self. */
+  void switch_away(std::unique_lock<std::mutex>& held, int32_t self) {
+    int32_t next = -1;
+    for (int32_t i = 0; i < (int32_t)tasks.size(); i++) {
+      const task_slot& t = *tasks[i];
+      if (t.done || t.suspended) { continue; }
+      if (next < 0 || t.wake_us < tasks[next]->wake_us || (t.wake_us == tasks[next]->wake_us && t.order < tasks[next]->order)) {
+        next = i;
+      }
+    }
+    if (next < 0) {
+      fprintf(stderr, "sim: every task has finished or is suspended at %.3f s\n", now / 1e6);
+      fflush(stdout);
+      std::_Exit(1);
+    }
+
+    if (tasks[next]->wake_us > now) {
+      // No task touches device state while the baton is held here, so the physics can step.
+      step_physics(now, tasks[next]->wake_us);
+      now = tasks[next]->wake_us;
+    }
+    running = next;
+    tasks[next]->baton.notify_one();
+
+    // A finished or stopped task never gets the baton back, and its thread waits here until exit.
+    task_slot& me = *tasks[self];
+    me.baton.wait(held, [&](){ return running == self && !me.done; });
+  }
+};
+
+scheduler& instance() {
+  static scheduler s;
+  return s;
+}
+
+thread_local int32_t task_id = 0;
+
+}
+
+uint64_t now_us() {
+  return instance().now;
+}
+
+uint32_t time_ms() {
+  return instance().now / 1000;
+}
+
+int32_t current_task() {
+  return task_id;
+}
+
+int32_t start_task(std::function<int()> body) {
+  scheduler& s = instance();
+  std::unique_lock<std::mutex> held(s.lock);
+  int32_t id = s.tasks.size();
+  s.tasks.push_back(std::make_unique<task_slot>());
+  s.tasks[id]->wake_us = s.now;
+  s.tasks[id]->order = ++s.order;
+
+  std::thread([id, body](){
+    task_id = id;
+    scheduler& s = instance();
+    {
+      std::unique_lock<std::mutex> held(s.lock);
+      task_slot& me = *s.tasks[id];
+      me.baton.wait(held, [&](){ return s.running == id && !me.done; });
+    }
+    body();
+    std::unique_lock<std::mutex> held(s.lock);
+    s.tasks[id]->done = true;
+    s.switch_away(held, id);
+  }).detach();
+  return id;
+}
+
+void sleep_until_us(uint64_t wake_us) {
+  scheduler& s = instance();
+  std::unique_lock<std::mutex> held(s.lock);
+  task_slot& me = *s.tasks[task_id];
+  me.wake_us = std::max(wake_us, s.now);
+  me.order = ++s.order;
+  s.switch_away(held, task_id);
+}
+
+void yield() {
+  // A little time passes, so a task polling in a loop can't stop the clock.
+  sleep_until_us(now_us() + 100);
+}
+
+bool stop_task(int32_t id) {
+  scheduler& s = instance();
+  std::unique_lock<std::mutex> held(s.lock);
+  if (id <= 0 || id >= (int32_t)s.tasks.size() || s.tasks[id]->done) { return false; }
+  s.tasks[id]->done = true;
+  if (id == task_id) { s.switch_away(held, id); }
+  return true;
+}
+
+bool suspend_task(int32_t id) {
+  scheduler& s = instance();
+  std::unique_lock<std::mutex> held(s.lock);
+  if (id < 0 || id >= (int32_t)s.tasks.size() || s.tasks[id]->done) { return false; }
+  s.tasks[id]->suspended = true;
+  if (id == task_id) {
+    s.switch_away(held, id);
+  }
+  return true;
+}
+
+bool resume_task(int32_t id) {
+  scheduler& s = instance();
+  std::unique_lock<std::mutex> held(s.lock);
+  if (id < 0 || id >= (int32_t)s.tasks.size() || s.tasks[id]->done) { return false; }
+  task_slot& t = *s.tasks[id];
+  if (t.suspended) {
+    t.suspended = false;
+    t.wake_us = std::max(t.wake_us, s.now);
+    t.order = ++s.order;
+  }
+  return true;
+}
+
+void exit(int code) {
+  fflush(stdout);
+  fflush(stderr);
+  std::_Exit(code);
+}
+
+}
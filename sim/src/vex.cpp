@@ -0,0 +1,460 @@
+#include "devices.h"
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+namespace vex {
+
+const color color::black = 0x000000;
+const color color::white = 0xFFFFFF;
+const color color::red = 0xFF0000;
+const color color::green = 0x00FF00;
+const color color::blue = 0x0000FF;
+const color color::yellow = 0xFFFF00;
+const color color::orange = 0xFFA500;
+const color color::purple = 0xFF00FF;
+const color color::cyan = 0x00FFFF;
+const color color::transparent = 0x000000;
+const color black = color::black;
+const color white = color::white;
+
+/** TIME AND TASKS */
+
+timer::timer() :
+  start_us(sim::now_us())
+{}
+
+double timer::time(timeUnits units) {
+  double elapsed_ms = (sim::now_us() - start_us) / 1000.0;
+  return units == timeUnits::sec ? elapsed_ms / 1000 : elapsed_ms;
+}
+
+uint32_t timer::time() {
+  return (sim::now_us() - start_us) / 1000;
+}
+
+void timer::clear() {
+  start_us = sim::now_us();
+}
+
+uint32_t timer::system() {
+  return sim::time_ms();
+}
+
+uint64_t timer::systemHighResolution() {
+  return sim::now_us();
+}
+
+void mutex::lock() {
+  while (!try_lock()) {
+    sim::sleep_until_us(sim::now_us() + 100);
+  }
+}
+
+bool mutex::try_lock() {
+  if (owner >= 0 && owner != sim::current_task()) { return false; }
+  owner = sim::current_task();
+  return true;
+}
+
+void mutex::unlock() {
+  owner = -1;
+}
+
+task::task(int (*callback)(void)) :
+  id(sim::start_task([callback](){ return callback(); }))
+{}
+
+task::task(int (*callback)(void*), void* arg) :
+  id(sim::start_task([callback, arg](){ return callback(arg); }))
+{}
+
+task::task(int (*callback)(void), int32_t priority) :
+  task(callback)
+{}
+
+bool task::stop() {
+  return sim::stop_task(id);
+}
+
+bool task::suspend() {
+  return sim::suspend_task(id);
+}
+
+bool task::resume() {
+  return sim::resume_task(id);
+}
+
+void task::sleep(uint32_t time) {
+  this_thread::sleep_for(time);
+}
+
+void task::yield() {
+  sim::yield();
+}
+
+void this_thread::sleep_for(uint32_t time) {
+  sim::sleep_until_us(sim::now_us() + time * 1000ull);
+}
+
+void this_thread::sleep_until(uint32_t time) {
+  sim::sleep_until_us(time * 1000ull);
+}
+
+void this_thread::yield() {
+  sim::yield();
+}
+
+int32_t this_thread::get_id() {
+  return sim::current_task();
+}
+
+void wait(double time, timeUnits units) {
+  this_thread::sleep_for(units == timeUnits::sec ? time * 1000 : time);
+}
+
+/** MOTORS */
+
+static double to_degrees(double value, rotationUnits units) {
+  return units == rotationUnits::rev ? value * 360 : value;
+}
+
+static double from_degrees(double value, rotationUnits units) {
+  return units == rotationUnits::rev ? value / 360 : value;
+}
+
+static float free_speed(const sim::motor_state& m) {
+  return m.drive ? sim::model().free_speed : sim::model().mechanism_free_speed;
+}
+
+static double to_rpm(const sim::motor_state& m, double value, velocityUnits units) {
+  if (units == velocityUnits::pct) { return value / 100 * free_speed(m); }
+  if (units == velocityUnits::dps) { return value / 6; }
+  return value;
+}
+
+motor::motor(int32_t index) :
+  device(index)
+{}
+
+motor::motor(int32_t index, bool reverse) :
+  device(index),
+  reversed(reverse)
+{}
+
+void motor::setStopping(brakeType mode) {
+  sim::motor_port(index_).stopping = mode;
+}
+
+void motor::setVelocity(double velocity, velocityUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  m.velocity_setting = std::abs(to_rpm(m, velocity, units));
+}
+
+void motor::setVelocity(double velocity, percentUnits units) {
+  setVelocity(velocity, velocityUnits::pct);
+}
+
+void motor::resetPosition() {
+  setPosition(0, rotationUnits::deg);
+}
+
+void motor::setPosition(double value, rotationUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  m.position_offset = m.shaft_position - to_degrees(value, units);
+}
+
+void motor::setTimeout(int32_t time, timeUnits units) {
+  sim::motor_port(index_).timeout = units == timeUnits::sec ? time * 1000 : time;
+}
+
+void motor::setMaxTorque(double value, percentUnits units) {
+  sim::motor_port(index_).max_torque_fraction = std::clamp(value / 100, 0.0, 1.0);
+}
+
+void motor::setMaxTorque(double value, torqueUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  float stall = m.drive ? sim::model().stall_torque : sim::model().mechanism_stall_torque;
+  m.max_torque_fraction = std::clamp(value / stall, 0.0, 1.0);
+}
+
+void motor::setMaxTorque(double value, currentUnits units) {
+  sim::motor_port(index_).max_torque_fraction = std::clamp(value / sim::model().current_limit, 0.0, 1.0);
+}
+
+void motor::spin(directionType dir) {
+  sim::motor_state& m = sim::motor_port(index_);
+  spin(dir, m.velocity_setting, velocityUnits::rpm);
+}
+
+void motor::spin(directionType dir, double voltage, voltageUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  double volts = units == voltageUnits::mV ? voltage / 1000 : voltage;
+  m.mode = sim::motor_mode::VOLTAGE;
+  m.command_voltage = dir == directionType::rev ? -volts : volts;
+}
+
+void motor::spin(directionType dir, double velocity, velocityUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  double target = to_rpm(m, velocity, units);
+  m.mode = sim::motor_mode::VELOCITY;
+  m.target_velocity = dir == directionType::rev ? -target : target;
+}
+
+bool motor::spinFor(double rotation, rotationUnits units, double velocity, velocityUnits units_v, bool waitForCompletion) {
+  sim::motor_state& m = sim::motor_port(index_);
+  m.velocity_setting = std::abs(to_rpm(m, velocity, units_v));
+  return spinFor(rotation, units, waitForCompletion);
+}
+
+bool motor::spinFor(directionType dir, double rotation, rotationUnits units, double velocity, velocityUnits units_v, bool waitForCompletion) {
+  return spinFor(dir == directionType::rev ? -rotation : rotation, units, velocity, units_v, waitForCompletion);
+}
+
+bool motor::spinFor(double rotation, rotationUnits units, bool waitForCompletion) {
+  sim::motor_state& m = sim::motor_port(index_);
+  m.mode = sim::motor_mode::POSITION;
+  m.target_position = m.shaft_position + to_degrees(rotation, units);
+  if (!waitForCompletion) { return false; }
+
+  uint32_t start_time = sim::time_ms();
+  while (!isDone()) {
+    if (m.timeout > 0 && sim::time_ms() - start_time > m.timeout) { return false; }
+    this_thread::sleep_for(10);
+  }
+  return true;
+}
+
+bool motor::spinFor(directionType dir, double rotation, rotationUnits units, bool waitForCompletion) {
+  return spinFor(dir == directionType::rev ? -rotation : rotation, units, waitForCompletion);
+}
+
+bool motor::isSpinning() {
+  return !isDone();
+}
+
+bool motor::isDone() {
+  sim::motor_state& m = sim::motor_port(index_);
+  if (m.mode != sim::motor_mode::POSITION) { return m.mode == sim::motor_mode::STOPPED; }
+  if (std::abs(m.target_position - m.shaft_position) < 3 && std::abs(m.shaft_velocity) < 5) {
+    // The motor holds once it gets there, the same as the brain does.
+    m.mode = sim::motor_mode::STOPPED;
+    m.stopped_with = brakeType::hold;
+    return true;
+  }
+  return false;
+}
+
+void motor::stop() {
+  stop(sim::motor_port(index_).stopping);
+}
+
+void motor::stop(brakeType mode) {
+  sim::motor_state& m = sim::motor_port(index_);
+  m.mode = sim::motor_mode::STOPPED;
+  m.stopped_with = mode;
+  m.target_position = m.shaft_position;
+}
+
+double motor::position(rotationUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  return from_degrees(m.shaft_position - m.position_offset, units);
+}
+
+double motor::velocity(velocityUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  if (units == velocityUnits::pct) { return m.shaft_velocity / free_speed(m) * 100; }
+  if (units == velocityUnits::dps) { return m.shaft_velocity * 6; }
+  return m.shaft_velocity;
+}
+
+double motor::velocity(percentUnits units) {
+  return velocity(velocityUnits::pct);
+}
+
+double motor::voltage(voltageUnits units) {
+  double volts = sim::motor_port(index_).applied_voltage;
+  return units == voltageUnits::mV ? volts * 1000 : volts;
+}
+
+double motor::current(currentUnits units) {
+  return sim::motor_port(index_).current;
+}
+
+double motor::current(percentUnits units) {
+  return sim::motor_port(index_).current / sim::model().current_limit * 100;
+}
+
+double motor::power(powerUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  return std::abs(m.applied_voltage * m.current);
+}
+
+double motor::torque(torqueUnits units) {
+  double torque = sim::motor_port(index_).torque;
+  return units == torqueUnits::InLb ? torque * 8.8507 : torque;
+}
+
+double motor::efficiency(percentUnits units) {
+  sim::motor_state& m = sim::motor_port(index_);
+  double input = std::abs(m.applied_voltage * m.current);
+  double output = std::abs(m.torque * m.shaft_velocity * 2 * M_PI / 60);
+  return input > 1e-3 ? std::min(output / input * 100, 100.0) : 0;
+}
+
+double motor::temperature(percentUnits units) {
+  return std::clamp((sim::motor_port(index_).temperature - 25) / 45 * 100, 0.0f, 100.0f);
+}
+
+double motor::temperature(temperatureUnits units) {
+  double celsius = sim::motor_port(index_).temperature;
+  return units == temperatureUnits::fahrenheit ? celsius * 9 / 5 + 32 : celsius;
+}
+
+/** SENSORS */
+
+rotation::rotation(int32_t index, bool reverse) :
+  device(index),
+  reversed(reverse)
+{}
+
+double rotation::position(rotationUnits units) {
+  double raw = sim::rotation_raw(index_) * (reversed ? -1 : 1);
+  return from_degrees(raw - sim::rotation_port(index_).position_offset, units);
+}
+
+double rotation::angle(rotationUnits units) {
+  double degrees = fmod(position(rotationUnits::deg), 360.0);
+  return from_degrees(degrees < 0 ? degrees + 360 : degrees, units);
+}
+
+double rotation::velocity(velocityUnits units) {
+  // Only mechanism encoders report a velocity, trackers are read through their position.
+  const sim::rotation_state& r = sim::rotation_port(index_);
+  if (r.kind != sim::rotation_state::source::MOTOR) { return 0; }
+  double rpm = sim::motor_port(r.motor_port).shaft_velocity * r.ratio * (reversed ? -1 : 1);
+  return units == velocityUnits::dps ? rpm * 6 : rpm;
+}
+
+void rotation::resetPosition() {
+  setPosition(0, rotationUnits::deg);
+}
+
+void rotation::setPosition(double value, rotationUnits units) {
+  double raw = sim::rotation_raw(index_) * (reversed ? -1 : 1);
+  sim::rotation_port(index_).position_offset = raw - to_degrees(value, units);
+}
+
+void inertial::calibrate() {
+  sim::inertial_port(index_).calibrated_at_us = sim::now_us() + 2000000;
+}
+
+bool inertial::isCalibrating() {
+  return sim::now_us() < sim::inertial_port(index_).calibrated_at_us;
+}
+
+double inertial::rotation(rotationUnits units) {
+  return sim::get_state().heading + sim::inertial_port(index_).offset;
+}
+
+double inertial::heading(rotationUnits units) {
+  double degrees = fmod(rotation(units), 360.0);
+  return degrees < 0 ? degrees + 360 : degrees;
+}
+
+double inertial::gyroRate(axisType axis, velocityUnits units) {
+  if (axis != axisType::zaxis) { return 0; }
+  double dps = sim::get_state().angular_velocity;
+  return units == velocityUnits::rpm ? dps / 6 : dps;
+}
+
+void inertial::setRotation(double value, rotationUnits units) {
+  sim::inertial_port(index_).offset = value - sim::get_state().heading;
+}
+
+void inertial::setHeading(double value, rotationUnits units) {
+  setRotation(value, units);
+}
+
+double distance::objectDistance(distanceUnits units) {
+  // Nothing in range reads 9999 mm, the same as the sensor.
+  float inches = sim::distance_reading(index_);
+  if (inches < 0) { return units == distanceUnits::in ? 9999 / 25.4 : (units == distanceUnits::cm ? 999.9 : 9999); }
+  if (units == distanceUnits::mm) { return inches * 25.4; }
+  if (units == distanceUnits::cm) { return inches * 2.54; }
+  return inches;
+}
+
+bool distance::isObjectDetected() {
+  return sim::distance_reading(index_) >= 0;
+}
+
+double optical::hue() {
+  return 0;
+}
+
+/** BRAIN */
+
+bool brain::sdcard::isInserted() {
+  return !sim::sd_path("").empty();
+}
+
+bool brain::sdcard::exists(const char* name) {
+  return size(name) >= 0;
+}
+
+int32_t brain::sdcard::size(const char* name) {
+  std::string path = sim::sd_path(name);
+  if (path.empty()) { return -1; }
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) { return -1; }
+  fseek(file, 0, SEEK_END);
+  int32_t length = ftell(file);
+  fclose(file);
+  return length;
+}
+
+int32_t brain::sdcard::loadfile(const char* name, uint8_t* buffer, int32_t length) {
+  std::string path = sim::sd_path(name);
+  FILE* file = path.empty() ? nullptr : fopen(path.c_str(), "rb");
+  if (!file) { return 0; }
+  int32_t read = fread(buffer, 1, length, file);
+  fclose(file);
+  return read;
+}
+
+static int32_t write_file(const char* name, uint8_t* buffer, int32_t length, const char* mode) {
+  std::string path = sim::sd_path(name);
+  FILE* file = path.empty() ? nullptr : fopen(path.c_str(), mode);
+  if (!file) { return 0; }
+  int32_t written = fwrite(buffer, 1, length, file);
+  fclose(file);
+  return written;
+}
+
+int32_t brain::sdcard::savefile(const char* name, uint8_t* buffer, int32_t length) {
+  return write_file(name, buffer, length, "wb");
+}
+
+int32_t brain::sdcard::appendfile(const char* name, uint8_t* buffer, int32_t length) {
+  return write_file(name, buffer, length, "ab");
+}
+
+uint32_t brain::battery::capacity(percentUnits units) {
+  const sim::robot_model& robot = sim::model();
+  float open_circuit = sim::get_power_stats().battery_voltage + robot.battery_resistance * sim::get_power_stats().total_current;
+  return std::clamp((open_circuit - (robot.battery_voltage - 1)) * 100, 0.0f, 100.0f);
+}
+
+double brain::battery::voltage(voltageUnits units) {
+  double volts = sim::get_power_stats().battery_voltage;
+  if (volts <= 0) { volts = sim::model().battery_voltage; }
+  return units == voltageUnits::mV ? volts * 1000 : volts;
+}
+
+double brain::battery::current(currentUnits units) {
+  return sim::get_power_stats().total_current;
+}
+
+}
@@ -10,7 +10,7 @@ PID::PID(float error, float kp, float ki, float kd, float starti) :
   starti(starti)
 {};
 
-PID::PID(float error, float kp, float ki, float kd, float starti, float settle_error, float settle_time, float timeout) :
+PID::PID(float error, float kp, float ki, float kd, float starti, float settle_error, float settle_time, float timeout, float settle_velocity, float settle_confirm_time) :
   error(error),
   kp(kp),
   ki(ki),
@@ -18,39 +18,73 @@ PID::PID(float error, float kp, float ki, float kd, float starti, float settle_e
   starti(starti),
   settle_error(settle_error),
   settle_time(settle_time),
-  timeout(timeout)
+  timeout(timeout),
+  settle_velocity(settle_velocity),
+  settle_confirm_time(settle_confirm_time)
 {};
 
 float PID::compute(float error) {
+  return compute(error, nominal_dt);
+}
+
+float PID::compute(float error, float dt) {
+  if (dt <= 0) { dt = nominal_dt; }
+  float dt_scale = dt / nominal_dt;
+
   if (fabs(error) < starti){
-    accumulated_error += error;
+    accumulated_error += error * dt_scale;
   }
   if ((error > 0 && previous_error < 0) || (error < 0 && previous_error > 0)) { 
     accumulated_error = 0; 
   }
 
-  output = kp * error + ki * accumulated_error + kd * (error - previous_error);
+  output = kp * error + ki * accumulated_error + kd * (error - previous_error) / dt_scale;
 
+  float error_rate = (error - previous_error) / dt * 1000;
   previous_error = error;
 
   if(fabs(error) < settle_error) {
-    time_spent_settled += 10;
+    time_spent_settled += dt;
   } else {
     time_spent_settled = 0;
   }
 
-  time_spent_running += 10;
+  if (fabs(error) < settle_error && fabs(error_rate) < settle_velocity) {
+    time_spent_still += dt;
+  } else {
+    time_spent_still = 0;
+  }
+
+  time_spent_running += dt;
 
   return output;
 }
 
 bool PID::is_settled(){
-  if (time_spent_running > timeout && timeout != 0) {
+  if (is_timed_out()) {
     return true;
   }
   if (time_spent_settled > settle_time) {
     return true;
   }
+  if (settle_velocity > 0 && time_spent_still > settle_confirm_time) {
+    return true;
+  }
   return false;
 }
 
+float PID::get_time_saved() const {
+  // Same order as is_settled(), only an early settle saves anything.
+  if (is_timed_out() || time_spent_settled > settle_time) {
+    return 0;
+  }
+  if (settle_velocity > 0 && time_spent_still > settle_confirm_time) {
+    return std::max(settle_time - time_spent_settled, 0.0f);
+  }
+  return 0;
+}
+
+bool PID::is_timed_out() const {
+  return time_spent_running > timeout && timeout != 0;
+}
+
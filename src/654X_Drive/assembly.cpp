@@ -15,6 +15,16 @@ Assembly::Assembly(mik::motor_group LB_motors, int LB_encoder_port, mik::motor i
   lift_piston(Brain.ThreeWirePort.Port[lift_piston_port])
 {};
 
+assembly_frame Assembly::capture_frame() {
+  assembly_frame frame;
+  frame.timestamp = vex::timer::system();
+  frame.LB_angle = reduce_0_to_360(LB_encoder.angle());
+  frame.intake_position = intake_motor.position(vex::rotationUnits::deg);
+  frame.ring_hue = ring_color_sensor.hue();
+  frame.ring_distance = ring_distance_sensor.objectDistance(mm);
+  return frame;
+}
+
 void Assembly::init_LB() {
   assembly.LB_goto_state = INACTIVE;
 
@@ -184,19 +194,21 @@ void Assembly::select_ring_sort_mode() {
 }
 
 bool Assembly::ring_sort() {
-  if (ring_distance_sensor.objectDistance(mm) < 50) {
+  assembly_frame frame = capture_frame();
+
+  if (frame.ring_distance < 50) {
     ring_distance_close = true;
-    distance_start = intake_motor.position(vex::rotationUnits::deg);
+    distance_start = frame.intake_position;
   }
 
-  if (ring_distance_close && std::abs(intake_motor.position(vex::rotationUnits::deg) - distance_start) > 500) {
+  if (ring_distance_close && std::abs(frame.intake_position - distance_start) > 500) {
     ring_distance_close = false;
   }
 
-  if (ring_color_sensor.hue() < color_max && ring_color_sensor.hue() > color_min && !ring_detected) {
+  if (frame.ring_hue < color_max && frame.ring_hue > color_min && !ring_detected) {
     ring_detected = true;
 
-    current_position = std::fmod(intake_motor.position(vex::rotationUnits::deg), full_rotation);
+    current_position = std::fmod(frame.intake_position, full_rotation);
     if (current_position < 0) {
         current_position += full_rotation;
     }
@@ -213,7 +225,7 @@ bool Assembly::ring_sort() {
   
   if (ring_detected) {
     unjam_intake = false;
-    float angle = std::fmod(intake_motor.position(deg), full_rotation);
+    float angle = std::fmod(frame.intake_position, full_rotation);
 
     if(angle < 0) {
       angle += full_rotation;
@@ -403,13 +415,20 @@ void Assembly::move_LB_to_angle(float angle, bool buffer_data) {
 
 void Assembly::move_LB_to_angle(float angle, float LB_max_voltage, float LB_settle_error, float LB_settle_time, float LB_timeout, float LB_kp, float LB_ki, float LB_kd, float LB_starti, bool buffer_data) {
   desired_angle = angle;
-  float start_angle = reduce_0_to_360(LB_encoder.angle());
-  PID turnPID(reduce_negative_180_to_180(angle - reduce_0_to_360(LB_encoder.angle())), LB_kp, LB_ki, LB_kd, LB_starti, LB_settle_error, LB_settle_time, LB_timeout);
+  assembly_frame frame = capture_frame();
+  float start_angle = frame.LB_angle;
+  PID turnPID(reduce_negative_180_to_180(angle - start_angle), LB_kp, LB_ki, LB_kd, LB_starti, LB_settle_error, LB_settle_time, LB_timeout);
 
   int state = assembly.LB_goto_state;
+  uint32_t prev_time = vex::timer::system();
 
   while(turnPID.is_settled() == false) {
-    float error = reduce_negative_180_to_180(angle - reduce_0_to_360(LB_encoder.angle()));
+    uint32_t time = vex::timer::system();
+    float dt = time - prev_time;
+    prev_time = time;
+    frame = capture_frame();
+
+    float error = reduce_negative_180_to_180(angle - frame.LB_angle);
     if (start_angle > angle || angle > 300) {
       if (error > 0) {
         if (error < -25 || error > 25) {
@@ -425,12 +444,12 @@ void Assembly::move_LB_to_angle(float angle, float LB_max_voltage, float LB_sett
       }
     }
     
-    float output = turnPID.compute(error);
+    float output = turnPID.compute(error, dt);
     
     output = clamp(output, -LB_max_voltage, LB_max_voltage);
 
     if (buffer_data) {
-      // add_to_graph_buffer({angle, (output / LB_max_voltage) * 100, reduce_0_to_360(LB_encoder.angle())});
+      // add_to_graph_buffer({angle, (output / LB_max_voltage) * 100, frame.LB_angle});
     }
     if (assembly.LB_goto_state != state) {
       break;
@@ -3,15 +3,6 @@
 using namespace vex;
 using namespace mik;
 
-drive_distance_params g_drive_distance_params_buffer{};
-turn_to_angle_params g_turn_to_angle_params_buffer{};
-swing_to_angle_params g_swing_to_angle_params_buffer{};
-turn_to_point_params g_turn_to_point_params_buffer{};
-swing_to_point_params g_swing_to_point_params_buffer{};
-drive_to_point_params g_drive_to_point_params_buffer{};
-drive_to_pose_params g_drive_to_pose_params_buffer{};
-follow_path_params g_follow_path_params_buffer{};
-
 Chassis::Chassis(mik::motor_group left_drive, mik::motor_group right_drive, int inertial_port, float inertial_scale, int forward_tracker_port, float forward_tracker_diameter, 
   float forward_tracker_center_distance, int sideways_tracker_port, float sideways_tracker_diameter, float sideways_tracker_center_distance):
     
@@ -33,6 +24,26 @@ Chassis::Chassis(mik::motor_group left_drive, mik::motor_group right_drive, int
     sideways_tracker_inch_to_deg_ratio(M_PI * sideways_tracker_diameter / 360.0)
 {
   odom.set_physical_distances(forward_tracker_center_distance, sideways_tracker_center_distance);
+  executor.on_tick = [this](){ capture_frame(); };
+  executor.on_finish = [this](uint32_t duration){
+    if (logging_compensation) {
+      compensation_log.push_back({ vex::timer::system(), duration, mik::filtered_battery_voltage(), this->left_drive.compensationRatio() });
+    }
+    if (reporting_settle) {
+      settle_report_entry entry = finished_settle;
+      entry.duration = duration;
+      settle_report.push_back(entry);
+    }
+    finished_settle = {};
+    queue_lock.lock();
+    if (running_segment >= 0) {
+      segment_timings[running_segment].end_time = vex::timer::system();
+      running_segment = -1;
+    }
+    queue_lock.unlock();
+  };
+  executor.next_motion = [this](motion& next){ return next_queued_motion(next); };
+  ekf.set_physical_distances(forward_tracker_center_distance, sideways_tracker_center_distance);
 }
 
 void Chassis::set_control_constants(float control_throttle_deadband, float control_throttle_min_output, float control_throttle_curve_gain, float control_turn_deadband, float control_turn_min_output, float control_turn_curve_gain) {
@@ -82,30 +93,93 @@ void Chassis::set_turn_exit_conditions(float turn_settle_error, float turn_settl
   this->turn_timeout = turn_timeout;
 }
 
+void Chassis::set_turn_early_settle_conditions(float turn_settle_velocity, float turn_settle_confirm_time) {
+  this->turn_settle_velocity = turn_settle_velocity;
+  this->turn_settle_confirm_time = turn_settle_confirm_time;
+}
+
 void Chassis::set_drive_exit_conditions(float drive_settle_error, float drive_settle_time, float drive_timeout) {
   this->drive_settle_error = drive_settle_error;
   this->drive_settle_time = drive_settle_time;
   this->drive_timeout = drive_timeout;
 }
 
+void Chassis::set_drive_early_settle_conditions(float drive_settle_velocity, float drive_settle_confirm_time) {
+  this->drive_settle_velocity = drive_settle_velocity;
+  this->drive_settle_confirm_time = drive_settle_confirm_time;
+}
+
 void Chassis::set_swing_exit_conditions(float swing_settle_error, float swing_settle_time, float swing_timeout) {
   this->swing_settle_error = swing_settle_error;
   this->swing_settle_time = swing_settle_time;
   this->swing_timeout = swing_timeout;
 }
 
+void Chassis::set_swing_early_settle_conditions(float swing_settle_velocity, float swing_settle_confirm_time) {
+  this->swing_settle_velocity = swing_settle_velocity;
+  this->swing_settle_confirm_time = swing_settle_confirm_time;
+}
+
+void Chassis::set_drive_slew_constants(float drive_slew_accelerate, float drive_slew_decelerate) {
+  this->drive_slew_accelerate = drive_slew_accelerate;
+  this->drive_slew_decelerate = drive_slew_decelerate;
+}
+
+void Chassis::set_drive_profile_constants(float drive_max_velocity, float drive_max_acceleration, float drive_max_jerk) {
+  this->drive_max_velocity = drive_max_velocity;
+  this->drive_max_acceleration = drive_max_acceleration;
+  this->drive_max_jerk = drive_max_jerk;
+}
+
+void Chassis::set_turn_profile_constants(float turn_max_velocity, float turn_max_acceleration, float turn_max_jerk) {
+  this->turn_max_velocity = turn_max_velocity;
+  this->turn_max_acceleration = turn_max_acceleration;
+  this->turn_max_jerk = turn_max_jerk;
+}
+
+void Chassis::set_drive_feedforward_constants(float ks, float kv, float ka, float kp) {
+  drive_feedforward = feedforward(ks, kv, ka, kp);
+}
+
+void Chassis::set_turn_feedforward_constants(float ks, float kv, float ka, float kp) {
+  turn_feedforward = feedforward(ks, kv, ka, kp);
+}
+
+bool Chassis::load_drive_feedforward_constants() {
+  if (!Brain.SDcard.isInserted() || !Brain.SDcard.exists("drive_feedforward.txt")) { return false; }
+
+  feedforward measured = drive_feedforward;
+  int found = 0;
+  for (const std::string& line : get_SD_file_txt("drive_feedforward.txt")) {
+    std::size_t colon = line.find(':');
+    if (colon == std::string::npos) { continue; }
+    std::string name = line.substr(0, colon);
+    float value = atof(line.substr(colon + 1).c_str());
+    if (name == "ks") { measured.ks = value; found++; }
+    if (name == "kv") { measured.kv = value; found++; }
+    if (name == "ka") { measured.ka = value; found++; }
+  }
+  if (found != 3) { return false; }
+
+  drive_feedforward = measured;
+  return true;
+}
+
 void Chassis::set_brake_type(vex::brakeType brake) {
   left_drive.setStopping(brake);
   right_drive.setStopping(brake);
 }
 
 void Chassis::wait() {
+  // The motion can't finish while the control thread is waiting on it.
+  if (executor.on_control_thread()) { return; }
   while(motion_running) {
     task::sleep(10);
   }
 }
 
 void Chassis::wait_until(float units) {
+  if (executor.on_control_thread()) { return; }
   while (distance_traveled < units && motion_running) {
     task::sleep(10);
   }
@@ -116,23 +190,263 @@ bool Chassis::is_in_motion() {
 }
 
 void Chassis::cancel_motion() {
-  drive_task.stop();
+  queue_lock.lock();
+  motion_queue.clear();
+  queue_lock.unlock();
+  executor.cancel();
+  if (!executor.on_control_thread()) {
+    while (!executor.wait_until_idle()) {
+      executor.cancel();
+    }
+  }
   motion_running = false;
   if (drive_min_voltage == 0) { stop_drive(hold); }
 }
 
+void Chassis::stop_motion_task(vex::task& motion_task) {
+  // Stopped first, as cancelling first would let the task run on through the rest of its motions.
+  // The control thread takes the queue lock while holding the executor's, so they're taken in that order.
+  executor.lock_motions();
+  queue_lock.lock();
+  motion_task.stop();
+  queue_lock.unlock();
+  executor.unlock_motions();
+  cancel_motion();
+}
+
+void Chassis::preempt_motion() {
+  // Queued segments are set up by the control thread once the previous segment has finished.
+  if (preparing_segment || !executor.is_running()) { return; }
+  queue_lock.lock();
+  motion_queue.clear();
+  queue_lock.unlock();
+  executor.cancel(true);
+  // On the control thread the old motion is finished at the start of the next tick, before the new one's first update.
+  if (executor.on_control_thread()) { return; }
+  // Anywhere else, the new motion can't set up until the control thread has let go of the old one.
+  while (!executor.wait_until_idle()) {
+    executor.cancel(true);
+  }
+}
+
+void Chassis::start_motion(const motion& new_motion) {
+  queue_lock.lock();
+  std::vector<motion_trigger> triggers;
+  triggers.swap(pending_triggers);
+  queue_lock.unlock();
+
+  motion started = new_motion;
+  if (!triggers.empty()) {
+    // Checked after update() so distance_traveled and the frame are from this tick.
+    std::function<bool()> update = new_motion.update;
+    float elapsed = 0;
+    started.update = [this, update, triggers, elapsed]() mutable {
+      bool running = update();
+      elapsed += executor.dt;
+      for (auto trigger = triggers.begin(); trigger != triggers.end();) {
+        if (trigger->condition(elapsed)) {
+          trigger->action();
+          trigger = triggers.erase(trigger);
+        } else {
+          trigger++;
+        }
+      }
+      return running;
+    };
+  }
+
+  if (preparing_segment) {
+    prepared_motion = started;
+    motion_prepared = true;
+    return;
+  }
+  executor.start(started);
+}
+
+void Chassis::queue_motion(const std::string& name, std::function<void()> start) {
+  queue_lock.lock();
+  if (motion_queue.empty() && running_segment < 0) {
+    segment_timings.clear();
+  }
+  segment_timings.push_back({ name, vex::timer::system() });
+  motion_queue.push_back({ start, segment_timings.size() - 1, {} });
+  motion_queue.back().triggers.swap(pending_triggers);
+  queue_lock.unlock();
+  executor.init();
+}
+
+bool Chassis::next_queued_motion(motion& next) {
+  queue_lock.lock();
+  if (motion_queue.empty()) {
+    queue_lock.unlock();
+    return false;
+  }
+  queued_segment segment = motion_queue.front();
+  motion_queue.erase(motion_queue.begin());
+  queue_lock.unlock();
+
+  // The motion function sets up from where the robot is now, and start_motion() keeps its motion here.
+  // Triggers added for a later motion are set aside so only the segment's own are attached.
+  queue_lock.lock();
+  std::vector<motion_trigger> later_triggers;
+  later_triggers.swap(pending_triggers);
+  pending_triggers.swap(segment.triggers);
+  queue_lock.unlock();
+  preparing_segment = true;
+  motion_prepared = false;
+  segment.start();
+  preparing_segment = false;
+  queue_lock.lock();
+  pending_triggers.swap(later_triggers);
+  queue_lock.unlock();
+  if (!motion_prepared) { return false; }
+
+  next = prepared_motion;
+  prepared_motion = motion{};
+  queue_lock.lock();
+  segment_timings[segment.timing_index].start_time = vex::timer::system();
+  running_segment = segment.timing_index;
+  queue_lock.unlock();
+  return true;
+}
+
+int Chassis::get_queue_size() {
+  queue_lock.lock();
+  int size = motion_queue.size();
+  queue_lock.unlock();
+  return size;
+}
+
+bool Chassis::is_queue_running() {
+  queue_lock.lock();
+  bool running = !motion_queue.empty() || running_segment >= 0;
+  queue_lock.unlock();
+  return running;
+}
+
+std::vector<motion_segment_timing> Chassis::get_segment_timings() {
+  queue_lock.lock();
+  std::vector<motion_segment_timing> copy = segment_timings;
+  queue_lock.unlock();
+  return copy;
+}
+
+void Chassis::clear_motion_queue() {
+  queue_lock.lock();
+  motion_queue.clear();
+  queue_lock.unlock();
+}
+
+void Chassis::wait_for_queue() {
+  if (executor.on_control_thread()) { return; }
+  while (is_queue_running()) {
+    task::sleep(10);
+  }
+}
+
+void Chassis::add_distance_trigger(float units, std::function<void()> action) {
+  queue_lock.lock();
+  pending_triggers.push_back({ [this, units](float){ return distance_traveled >= units; }, action });
+  queue_lock.unlock();
+}
+
+void Chassis::add_region_trigger(float X_position, float Y_position, float radius, std::function<void()> action) {
+  point center = { mirror_x(X_position, x_pos_mirrored_), mirror_y(Y_position, y_pos_mirrored_) };
+  queue_lock.lock();
+  pending_triggers.push_back({ [this, center, radius](float){ return hypot(frame.odom_pose.x - center.x, frame.odom_pose.y - center.y) < radius; }, action });
+  queue_lock.unlock();
+}
+
+void Chassis::add_heading_trigger(float angle, float tolerance, std::function<void()> action) {
+  angle = mirror_angle(angle, angles_mirrored_);
+  queue_lock.lock();
+  pending_triggers.push_back({ [this, angle, tolerance](float){ return fabs(frame.rotation.error_to(angle)) < tolerance; }, action });
+  queue_lock.unlock();
+}
+
+void Chassis::add_time_trigger(float time, std::function<void()> action) {
+  queue_lock.lock();
+  pending_triggers.push_back({ [time](float elapsed){ return elapsed >= time; }, action });
+  queue_lock.unlock();
+}
+
 void Chassis::drive_with_voltage(float left_voltage, float right_voltage){
   left_drive.spin(vex::fwd, left_voltage, volt);
   right_drive.spin(vex::fwd, right_voltage, volt);
+  left_slew.reset(left_voltage);
+  right_slew.reset(right_voltage);
+}
+
+void Chassis::drive_with_slew(float left_voltage, float right_voltage, float accelerate, float decelerate) {
+  left_slew.accelerate_rate = accelerate;
+  left_slew.decelerate_rate = decelerate;
+  right_slew.accelerate_rate = accelerate;
+  right_slew.decelerate_rate = decelerate;
+  drive_with_voltage(left_slew.limit(left_voltage, executor.dt), right_slew.limit(right_voltage, executor.dt));
+}
+
+void Chassis::swing_with_slew(bool left_side, float voltage, float accelerate, float decelerate) {
+  slew_limiter& driven_slew = left_side ? left_slew : right_slew;
+  driven_slew.accelerate_rate = accelerate;
+  driven_slew.decelerate_rate = decelerate;
+  (left_side ? left_drive : right_drive).spin(vex::fwd, driven_slew.limit(voltage, executor.dt), volt);
+  (left_side ? right_drive : left_drive).stop(hold);
+  (left_side ? right_slew : left_slew).reset(0);
+}
+
+void Chassis::drive_with_velocity(float left_velocity, float right_velocity, float left_acceleration, float right_acceleration, float max_voltage) {
+  float left_voltage = drive_feedforward.compute(left_velocity, left_acceleration, get_left_velocity());
+  float right_voltage = drive_feedforward.compute(right_velocity, right_acceleration, get_right_velocity());
+  drive_with_voltage(clamp(left_voltage, -max_voltage, max_voltage), clamp(right_voltage, -max_voltage, max_voltage));
+}
+
+void Chassis::capture_frame() {
+  sensor_frame captured;
+  captured.timestamp = vex::timer::system();
+  captured.rotation = get_rotation();
+  captured.heading = captured.rotation.wrapped();
+  captured.heading_rate = inertial.gyroRate(vex::axisType::zaxis, vex::velocityUnits::dps) * 360.0 / inertial_scale;
+  captured.forward_tracker = get_ForwardTracker_position();
+  captured.sideways_tracker = get_SidewaysTracker_position();
+  captured.left_velocity = get_left_velocity();
+  captured.right_velocity = get_right_velocity();
+  captured.left_current = left_drive.averageCurrent();
+  captured.right_current = right_drive.averageCurrent();
+  captured.odom_pose = get_pose();
+
+  frame_lock.lock();
+  frame = captured;
+  frame_lock.unlock();
+}
+
+sensor_frame Chassis::get_frame() {
+  frame_lock.lock();
+  sensor_frame copy = frame;
+  frame_lock.unlock();
+  return copy;
+}
+
+float Chassis::get_left_velocity() {
+  return left_drive.averageVelocity(vex::rpm) * drive_gear_ratio * M_PI * drive_wheel_diameter / 60;
+}
+
+float Chassis::get_right_velocity() {
+  return right_drive.averageVelocity(vex::rpm) * drive_gear_ratio * M_PI * drive_wheel_diameter / 60;
 }
 
 void Chassis::stop_drive(vex::brakeType brake) {
   left_drive.stop(brake);
   right_drive.stop(brake);
+  left_slew.reset();
+  right_slew.reset();
 }
 
 float Chassis::get_absolute_heading(){ 
-  return(reduce_0_to_360(inertial.rotation() * 360.0 / inertial_scale)); 
+  return get_rotation().wrapped(); 
+}
+
+unwrapped_heading Chassis::get_rotation() {
+  return unwrapped_heading(inertial.rotation() * 360.0 / inertial_scale);
 }
 
 void Chassis::mirror_all_auton_angles() {
@@ -159,9 +473,50 @@ float Chassis::get_SidewaysTracker_position() {
     return(sideways_tracker.position(vex::deg) * sideways_tracker_inch_to_deg_ratio);
 }
 
+int32_t Chassis::get_ForwardTracker_ticks() {
+  return lround(forward_tracker.position(vex::deg) * 100);
+}
+
+int32_t Chassis::get_SidewaysTracker_ticks() {
+  return lround(sideways_tracker.position(vex::deg) * 100);
+}
+
+double Chassis::get_precise_heading() {
+  double heading = fmod(inertial.rotation() * 360.0 / inertial_scale, 360.0);
+  return heading < 0 ? heading + 360 : heading;
+}
+
 void Chassis::position_track() {
   while(1) {
-    odom.update_position(get_ForwardTracker_position(), get_SidewaysTracker_position(), get_absolute_heading());
+    if (coordinates_pending) {
+      apply_coordinates(pending_coordinates.x, pending_coordinates.y, pending_coordinates.theta);
+      coordinates_pending = false;
+    }
+    odom_sample sample = get_odom_sample();
+    if (odom_precision) {
+      odom.update_position_ticks(get_ForwardTracker_ticks(), get_SidewaysTracker_ticks(), get_precise_heading());
+    } else {
+      odom.update_position(sample.forward_tracker, sample.sideways_tracker, sample.heading);
+    }
+    ekf.update(sample);
+    if (localization_enabled && localizer.get_beam_count() > 0 && sample.timestamp - last_localized.timestamp >= 10) {
+      point corrected = odom.position;
+      localize(localizer, last_localized, sample, corrected);
+      ekf.position.x += corrected.x - odom.position.x;
+      ekf.position.y += corrected.y - odom.position.y;
+      odom.position = corrected;
+      last_localized = sample;
+    }
+    if (logging_odom && odom_log.size() < odom_log.capacity()) {
+      odom_log.push_back(sample);
+    }
+
+    if (selected_odom_mode == odom_mode::EKF) {
+      pose_lock.publish(ekf.position.x, ekf.position.y, ekf.get_orientation_deg(), sample.timestamp);
+    } else {
+      pose_lock.publish(odom.position.x, odom.position.y, reduce_0_to_360(odom.orientation_deg), sample.timestamp);
+    }
+    history.push(get_pose());
     vex::task::sleep(5);
   }
 }
@@ -177,25 +532,232 @@ void Chassis::set_heading(float orientation_deg){
 
 void Chassis::set_coordinates(float X_position, float Y_position, float orientation_deg) {
   position_tracking = true;
-  forward_tracker.resetPosition();
-  sideways_tracker.resetPosition();
-
   orientation_deg = mirror_angle(orientation_deg, angles_mirrored_);
   X_position = mirror_x(X_position, x_pos_mirrored_);
   Y_position = mirror_y(Y_position, y_pos_mirrored_);
 
-  odom.set_position({X_position, Y_position}, orientation_deg, get_ForwardTracker_position(), get_SidewaysTracker_position());
+  if (!odom_task_started) {
+    apply_coordinates(X_position, Y_position, orientation_deg);
+    odom_task = vex::task(position_track_task);
+    odom_task.setPriority(0);
+    odom_task_started = true;
+    return;
+  }
+  pending_coordinates.x = X_position;
+  pending_coordinates.y = Y_position;
+  pending_coordinates.theta = orientation_deg;
+  coordinates_pending = true;
+  while (coordinates_pending) {
+    task::sleep(1);
+  }
+}
+
+void Chassis::apply_coordinates(float X_position, float Y_position, float orientation_deg) {
+  forward_tracker.resetPosition();
+  sideways_tracker.resetPosition();
+  // The sample seeds the filters, so it has to read the new heading.
   set_heading(orientation_deg);
-  odom_task = vex::task(position_track_task);
-  odom_task.setPriority(0);
+
+  odom_sample sample = get_odom_sample();
+  odom.set_position({X_position, Y_position}, orientation_deg, sample.forward_tracker, sample.sideways_tracker);
+  if (odom_precision) {
+    odom.set_position_ticks({X_position, Y_position}, reduce_0_to_360(orientation_deg), get_ForwardTracker_ticks(), get_SidewaysTracker_ticks(), M_PI * forward_tracker_diameter / 36000.0, M_PI * sideways_tracker_diameter / 36000.0);
+  }
+  ekf.set_position({X_position, Y_position}, orientation_deg, sample);
+  pose_lock.publish(X_position, Y_position, reduce_0_to_360(orientation_deg), sample.timestamp);
+  log_start = get_pose();
+  localizer.reset({X_position, Y_position}, orientation_deg);
+  last_localized = sample;
+  // Poses from before the reset are in the old coordinates.
+  history.clear();
+  history.push(get_pose());
 }
 
 float Chassis::get_X_position() {
-  return(odom.position.x);
+  return(get_pose().x);
 }
 
 float Chassis::get_Y_position() {
-  return(odom.position.y);
+  return(get_pose().y);
+}
+
+pose Chassis::get_pose() {
+  return pose_lock.read();
+}
+
+bool Chassis::get_pose_at(uint32_t timestamp, pose& result) {
+  return history.sample(timestamp, result);
+}
+
+void Chassis::set_odom_precision(bool precise) {
+  odom_precision = precise;
+}
+
+void Chassis::set_odom_mode(odom_mode mode) {
+  selected_odom_mode = mode;
+}
+
+void Chassis::set_voltage_compensation(bool enabled, float nominal_voltage) {
+  left_drive.setVoltageCompensation(enabled, nominal_voltage);
+  right_drive.setVoltageCompensation(enabled, nominal_voltage);
+}
+
+void Chassis::start_compensation_log() {
+  logging_compensation = false;
+  compensation_log.clear();
+  compensation_log.reserve(128);
+  logging_compensation = true;
+}
+
+void Chassis::start_settle_report() {
+  reporting_settle = false;
+  settle_report.clear();
+  settle_report.reserve(64);
+  reporting_settle = true;
+}
+
+std::vector<settle_report_entry> Chassis::get_settle_report() {
+  return settle_report;
+}
+
+void Chassis::report_settle(const PID& settled_pid) {
+  finished_settle = { 0, settled_pid.get_time_saved(), settled_pid.time_spent_settled, settled_pid.is_timed_out() };
+}
+
+bool Chassis::save_compensation_log(const std::string& file_name) {
+  logging_compensation = false;
+  if (!Brain.SDcard.isInserted() || compensation_log.empty()) { return false; }
+
+  std::string output = "\ntimestamp duration battery ratio";
+  char line[64];
+  for (const compensation_entry& entry : compensation_log) {
+    snprintf(line, sizeof(line), "\n%lu %lu %.2f %.3f", (unsigned long)entry.timestamp, (unsigned long)entry.duration, entry.battery_voltage, entry.ratio);
+    output += line;
+  }
+  std::vector<char> buffer(output.begin(), output.end());
+  Brain.SDcard.savefile(file_name.c_str(), reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+  return true;
+}
+
+void Chassis::add_localization_sensor(vex::distance& sensor, float x_offset, float y_offset, float angle) {
+  int index = localizer.get_beam_count();
+  if (!localizer.add_beam({ x_offset, y_offset, angle })) { return; }
+  localization_sensors[index] = &sensor;
+}
+
+void Chassis::set_localization(bool enabled) {
+  localization_enabled = enabled;
+}
+
+void Chassis::localize(particle_filter& filter, const odom_sample& from, const odom_sample& to, point& position) {
+  float heading_delta = to_rad(reduce_negative_180_to_180(to.heading - from.heading));
+  float forward = to.forward_tracker - from.forward_tracker + forward_tracker_center_distance * heading_delta;
+  float sideways = to.sideways_tracker - from.sideways_tracker + sideways_tracker_center_distance * heading_delta;
+  filter.predict(forward, sideways, to.heading);
+  if (!filter.update(to.distances)) { return; }
+  if (filter.get_spread() > localization_max_spread) { return; }
+
+  pose estimate = filter.estimate();
+  position.x += (estimate.x - position.x) * localization_gain;
+  position.y += (estimate.y - position.y) * localization_gain;
+}
+
+void Chassis::get_pose_covariance(float result[3][3]) {
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      result[i][j] = ekf.covariance[i][j];
+    }
+  }
+}
+
+odom_sample Chassis::get_odom_sample() {
+  float drive_inch_per_deg = drive_gear_ratio * M_PI * drive_wheel_diameter / 360;
+  odom_sample sample;
+  sample.timestamp = vex::timer::system();
+  sample.forward_tracker = get_ForwardTracker_position();
+  sample.sideways_tracker = get_SidewaysTracker_position();
+  sample.left_drive = left_drive.position(vex::deg) * drive_inch_per_deg;
+  sample.right_drive = right_drive.position(vex::deg) * drive_inch_per_deg;
+  sample.heading = get_absolute_heading();
+  sample.heading_rate = inertial.gyroRate(vex::axisType::zaxis, vex::velocityUnits::dps) * 360.0 / inertial_scale;
+  for (int i = 0; i < localizer.get_beam_count(); i++) {
+    sample.distances[i] = localization_sensors[i]->objectDistance(vex::distanceUnits::in);
+  }
+  return sample;
+}
+
+void Chassis::start_odom_log(size_t max_samples) {
+  logging_odom = false;
+  odom_log.clear();
+  odom_log.reserve(max_samples);
+  logging_odom = true;
+}
+
+bool Chassis::save_odom_log(const std::string& file_name) {
+  logging_odom = false;
+  if (!Brain.SDcard.isInserted() || odom_log.empty()) { return false; }
+
+  std::string output = "\nstart " + to_string_float(log_start.x, 3) + " " + to_string_float(log_start.y, 3) + " " + to_string_float(log_start.theta, 3);
+  char line[128];
+  for (const odom_sample& sample : odom_log) {
+    snprintf(line, sizeof(line), "\n%lu %.4f %.4f %.4f %.4f %.3f %.2f %.2f %.2f %.2f %.2f", (unsigned long)sample.timestamp, sample.forward_tracker, sample.sideways_tracker, sample.left_drive, sample.right_drive, sample.heading, sample.heading_rate, sample.distances[0], sample.distances[1], sample.distances[2], sample.distances[3]);
+    output += line;
+  }
+  std::vector<char> buffer(output.begin(), output.end());
+  Brain.SDcard.savefile(file_name.c_str(), reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+  return true;
+}
+
+bool Chassis::replay_odom_log(const std::string& file_name, pose& arc_result, pose& ekf_result, pose& mcl_result, pose& start_result) {
+  if (!SD_text_file_exists(file_name)) { return false; }
+
+  // get_SD_file_txt() returns the last line first.
+  std::vector<std::string> lines = get_SD_file_txt(file_name);
+  std::vector<odom_sample> samples;
+  bool found_start = false;
+  for (auto line = lines.rbegin(); line != lines.rend(); line++) {
+    if (line->compare(0, 6, "start ") == 0) {
+      found_start = sscanf(line->c_str(), "start %f %f %f", &start_result.x, &start_result.y, &start_result.theta) == 3;
+      continue;
+    }
+    odom_sample sample;
+    unsigned long timestamp;
+    // Logs from before localization have no distance readings, they're left at 0.
+    int fields = sscanf(line->c_str(), "%lu %f %f %f %f %f %f %f %f %f %f", &timestamp, &sample.forward_tracker, &sample.sideways_tracker, &sample.left_drive, &sample.right_drive, &sample.heading, &sample.heading_rate, &sample.distances[0], &sample.distances[1], &sample.distances[2], &sample.distances[3]);
+    if (fields < 7) { continue; }
+    sample.timestamp = timestamp;
+    samples.push_back(sample);
+  }
+  if (!found_start || samples.empty()) { return false; }
+
+  // Fresh estimators so the live ones keep running undisturbed.
+  class odom replay_odom;
+  class odom replay_mcl_odom;
+  pose_ekf replay_ekf = ekf;
+  // The particle pool is too big for a task's stack.
+  std::unique_ptr<particle_filter> replay_localizer(new particle_filter(localizer));
+  replay_mcl_odom.set_physical_distances(forward_tracker_center_distance, sideways_tracker_center_distance);
+  replay_mcl_odom.set_position({start_result.x, start_result.y}, start_result.theta, samples[0].forward_tracker, samples[0].sideways_tracker);
+  replay_localizer->reset({start_result.x, start_result.y}, start_result.theta);
+  odom_sample last_replay_localized = samples[0];
+  replay_odom.set_physical_distances(forward_tracker_center_distance, sideways_tracker_center_distance);
+  replay_odom.set_position({start_result.x, start_result.y}, start_result.theta, samples[0].forward_tracker, samples[0].sideways_tracker);
+  replay_ekf.set_position({start_result.x, start_result.y}, start_result.theta, samples[0]);
+
+  for (const odom_sample& sample : samples) {
+    replay_odom.update_position(sample.forward_tracker, sample.sideways_tracker, sample.heading);
+    replay_ekf.update(sample);
+    replay_mcl_odom.update_position(sample.forward_tracker, sample.sideways_tracker, sample.heading);
+    if (replay_localizer->get_beam_count() > 0 && sample.timestamp - last_replay_localized.timestamp >= 10) {
+      localize(*replay_localizer, last_replay_localized, sample, replay_mcl_odom.position);
+      last_replay_localized = sample;
+    }
+  }
+
+  arc_result = { (float)replay_odom.position.x, (float)replay_odom.position.y, reduce_0_to_360(replay_odom.orientation_deg), samples.back().timestamp, (uint32_t)samples.size() };
+  mcl_result = { (float)replay_mcl_odom.position.x, (float)replay_mcl_odom.position.y, reduce_0_to_360(replay_mcl_odom.orientation_deg), samples.back().timestamp, (uint32_t)samples.size() };
+  ekf_result = { (float)replay_ekf.position.x, (float)replay_ekf.position.y, replay_ekf.get_orientation_deg(), samples.back().timestamp, (uint32_t)samples.size() };
+  return true;
 }
 
 void Chassis::disable_control() {
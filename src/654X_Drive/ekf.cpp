@@ -0,0 +1,116 @@
+#include "vex.h"
+
+pose_ekf::pose_ekf() {}
+
+void pose_ekf::set_physical_distances(float ForwardTracker_center_distance, float SidewaysTracker_center_distance) {
+  this->ForwardTracker_center_distance = ForwardTracker_center_distance;
+  this->SidewaysTracker_center_distance = SidewaysTracker_center_distance;
+}
+
+void pose_ekf::set_position(point position, float orientation_deg, const odom_sample& sample) {
+  this->position = position;
+  heading_rad = to_rad(orientation_deg);
+  last = sample;
+  rejected_ticks = 0;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      covariance[i][j] = 0;
+    }
+  }
+  covariance[0][0] = .01;
+  covariance[1][1] = .01;
+  covariance[2][2] = heading_noise * heading_noise;
+}
+
+float pose_ekf::get_orientation_deg() {
+  return reduce_0_to_360(to_deg(heading_rad));
+}
+
+void pose_ekf::update(const odom_sample& sample) {
+  float dt = (sample.timestamp - last.timestamp) / 1000.0;
+  float heading_delta = to_rad(sample.heading_rate) * dt;
+
+  // Trackers that aren't at the center of rotation also move while turning in place.
+  float tracker_rolled = sample.forward_tracker - last.forward_tracker;
+  float tracker_forward = tracker_rolled + ForwardTracker_center_distance * heading_delta;
+  float tracker_sideways = sample.sideways_tracker - last.sideways_tracker + SidewaysTracker_center_distance * heading_delta;
+  float drive_forward = ((sample.left_drive - last.left_drive) + (sample.right_drive - last.right_drive)) / 2;
+  last = sample;
+
+  // Small floors keep the variances above 0 when the robot is still.
+  float tracker_variance = pow(tracker_noise * fabs(tracker_forward), 2) + 1e-6;
+  float drive_variance = pow(drive_noise * fabs(drive_forward), 2) + 1e-6;
+  float forward, forward_variance;
+  if (fabs(tracker_forward - drive_forward) > gate * sqrt(tracker_variance + drive_variance)) {
+    rejected_ticks++;
+    if (fabs(tracker_rolled) < .1 * fabs(drive_forward)) {
+      forward = drive_forward;
+      forward_variance = drive_variance;
+    } else {
+      forward = tracker_forward;
+      forward_variance = tracker_variance;
+    }
+  } else {
+    forward_variance = 1 / (1 / tracker_variance + 1 / drive_variance);
+    forward = forward_variance * (tracker_forward / tracker_variance + drive_forward / drive_variance);
+  }
+  float sideways_variance = pow(tracker_noise * fabs(tracker_sideways), 2) + 1e-6;
+  float heading_variance = pow(gyro_noise * fabs(heading_delta), 2) + gyro_rate_noise * gyro_rate_noise;
+
+  // Predict, moving along the chord at the average heading over the tick.
+  float mid = heading_rad + heading_delta / 2;
+  float s = sin(mid);
+  float c = cos(mid);
+  float dx_dheading = forward * c - tracker_sideways * s;
+  float dy_dheading = -forward * s - tracker_sideways * c;
+  position.x += forward * s + tracker_sideways * c;
+  position.y += forward * c - tracker_sideways * s;
+  heading_rad += heading_delta;
+
+  // P = F P F' + G Q G', with F the jacobian over the state and G over (forward, sideways, heading_delta).
+  float F[3][3] = {
+    { 1, 0, dx_dheading },
+    { 0, 1, dy_dheading },
+    { 0, 0, 1 }
+  };
+  float G[3][3] = {
+    { s, c, dx_dheading / 2 },
+    { c, -s, dy_dheading / 2 },
+    { 0, 0, 1 }
+  };
+  float Q[3] = { forward_variance, sideways_variance, heading_variance };
+
+  float FP[3][3] = {};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        FP[i][j] += F[i][k] * covariance[k][j];
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      float sum = 0;
+      for (int k = 0; k < 3; k++) {
+        sum += FP[i][k] * F[j][k] + G[i][k] * Q[k] * G[j][k];
+      }
+      covariance[i][j] = sum;
+    }
+  }
+
+  // Correct heading with the inertial heading, H = [0, 0, 1].
+  float innovation = to_rad(reduce_negative_180_to_180(sample.heading - to_deg(heading_rad)));
+  float innovation_variance = covariance[2][2] + heading_noise * heading_noise;
+  float gain[3] = { covariance[0][2] / innovation_variance, covariance[1][2] / innovation_variance, covariance[2][2] / innovation_variance };
+  position.x += gain[0] * innovation;
+  position.y += gain[1] * innovation;
+  heading_rad += gain[2] * innovation;
+
+  float heading_row[3] = { covariance[2][0], covariance[2][1], covariance[2][2] };
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      covariance[i][j] -= gain[i] * heading_row[j];
+    }
+  }
+  heading_rad = to_rad(reduce_0_to_360(to_deg(heading_rad)));
+}
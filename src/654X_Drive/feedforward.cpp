@@ -0,0 +1,94 @@
+#include "vex.h"
+
+feedforward::feedforward() {}
+
+feedforward::feedforward(float ks, float kv, float ka, float kp) :
+  ks(ks),
+  kv(kv),
+  ka(ka),
+  kp(kp)
+{}
+
+float feedforward::compute(float velocity, float acceleration) {
+  float static_output = 0;
+  if (velocity != 0) {
+    static_output = ks * sign(velocity);
+  }
+  return static_output + kv * velocity + ka * acceleration;
+}
+
+float feedforward::compute(float velocity, float acceleration, float measured_velocity) {
+  return compute(velocity, acceleration) + kp * (velocity - measured_velocity);
+}
+
+float fit_feedforward(const std::vector<feedforward_sample>& samples, float min_velocity, float dt, feedforward& result) {
+  // Fitting acceleration directly amplifies encoder noise, so fit the discrete model
+  // next_velocity = alpha * velocity + beta * voltage + gamma * sign(velocity) instead,
+  // with normal equations (X^T X) b = X^T y, and convert back to kS, kV and kA after.
+  double xtx[3][3] = {};
+  double xty[3] = {};
+  double y_sum = 0;
+  double y_squared_sum = 0;
+  int count = 0;
+
+  for (const feedforward_sample& sample : samples) {
+    if (fabs(sample.velocity) < min_velocity) { continue; }
+    double x[3] = { sample.velocity, sample.voltage, (double)sign(sample.velocity) };
+    double y = sample.velocity + sample.acceleration * dt;
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        xtx[r][c] += x[r] * x[c];
+      }
+      xty[r] += x[r] * y;
+    }
+    y_sum += y;
+    y_squared_sum += y * y;
+    count++;
+  }
+  if (count < 10) { return -1; }
+
+  // Gaussian elimination with partial pivoting.
+  double a[3][4];
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      a[r][c] = xtx[r][c];
+    }
+    a[r][3] = xty[r];
+  }
+  for (int col = 0; col < 3; col++) {
+    int pivot = col;
+    for (int r = col + 1; r < 3; r++) {
+      if (fabs(a[r][col]) > fabs(a[pivot][col])) { pivot = r; }
+    }
+    if (fabs(a[pivot][col]) < 1e-9) { return -1; }
+    for (int c = 0; c < 4; c++) {
+      std::swap(a[col][c], a[pivot][c]);
+    }
+    for (int r = 0; r < 3; r++) {
+      if (r == col) { continue; }
+      double factor = a[r][col] / a[col][col];
+      for (int c = col; c < 4; c++) {
+        a[r][c] -= factor * a[col][c];
+      }
+    }
+  }
+  double alpha = a[0][3] / a[0][0];
+  double beta = a[1][3] / a[1][1];
+  double gamma = a[2][3] / a[2][2];
+  if (beta <= 0 || alpha <= 0 || alpha >= 1) { return -1; }
+
+  double residual_sum = 0;
+  for (const feedforward_sample& sample : samples) {
+    if (fabs(sample.velocity) < min_velocity) { continue; }
+    double y = sample.velocity + sample.acceleration * dt;
+    double predicted = alpha * sample.velocity + beta * sample.voltage + gamma * sign(sample.velocity);
+    residual_sum += (y - predicted) * (y - predicted);
+  }
+  double total_sum = y_squared_sum - y_sum * y_sum / count;
+
+  // Exact discretization of dv/dt = (V - kS * sign(v) - kV * v) / kA over one dt.
+  result.kv = (1 - alpha) / beta;
+  result.ka = -result.kv * dt / log(alpha);
+  result.ks = -gamma / beta;
+  return total_sum > 0 ? 1 - residual_sum / total_sum : 0;
+}
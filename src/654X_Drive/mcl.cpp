@@ -0,0 +1,195 @@
+#include "vex.h"
+
+particle_filter::particle_filter() {
+  const wall_segment field[] = {
+    { {-72, -72}, {-72, 72} },
+    { {-72, 72}, {72, 72} },
+    { {72, 72}, {72, -72} },
+    { {72, -72}, {-72, -72} }
+  };
+  set_walls(field, 4);
+  reset({0, 0}, 0);
+}
+
+void particle_filter::set_walls(const wall_segment* walls, int count) {
+  wall_count = std::min(count, max_walls);
+  for (int i = 0; i < wall_count; i++) {
+    this->walls[i] = walls[i];
+  }
+}
+
+bool particle_filter::add_beam(const distance_beam& beam) {
+  if (beam_count >= max_beams) { return false; }
+  beams[beam_count++] = beam;
+  return true;
+}
+
+int particle_filter::get_beam_count() {
+  return beam_count;
+}
+
+void particle_filter::set_particle_count(int count) {
+  particle_count = clamp(count, 1, max_particles);
+}
+
+void particle_filter::reset(point position, float orientation_deg, float spread) {
+  for (int i = 0; i < particle_count; i++) {
+    particles[i].x = position.x + gaussian() * spread;
+    particles[i].y = position.y + gaussian() * spread;
+    particles[i].heading = orientation_deg;
+    particles[i].weight = 1.0 / particle_count;
+  }
+}
+
+void particle_filter::predict(float forward, float sideways, float orientation_deg) {
+  float travelled = hypot(forward, sideways);
+  for (int i = 0; i < particle_count; i++) {
+    particle& p = particles[i];
+    float f = forward + gaussian() * motion_noise * travelled;
+    float s = sideways + gaussian() * motion_noise * travelled;
+    float new_heading = orientation_deg + gaussian() * heading_noise;
+
+    float mid = to_rad(p.heading + reduce_negative_180_to_180(new_heading - p.heading) / 2);
+    float sin_mid = sin(mid);
+    float cos_mid = cos(mid);
+    p.x += f * sin_mid + s * cos_mid;
+    p.y += f * cos_mid - s * sin_mid;
+    p.heading = new_heading;
+  }
+}
+
+float particle_filter::ray_cast(float x, float y, float angle_deg) {
+  float dx = sin(to_rad(angle_deg));
+  float dy = cos(to_rad(angle_deg));
+  float nearest = max_range;
+
+  for (int i = 0; i < wall_count; i++) {
+    float ex = walls[i].end.x - walls[i].start.x;
+    float ey = walls[i].end.y - walls[i].start.y;
+    float denominator = dx * ey - dy * ex;
+    if (fabs(denominator) < 1e-6) { continue; }
+
+    // Solve origin + t * direction = start + u * (end - start).
+    float wx = walls[i].start.x - x;
+    float wy = walls[i].start.y - y;
+    float t = (wx * ey - wy * ex) / denominator;
+    float u = (wx * dy - wy * dx) / denominator;
+    if (t > 0 && u >= 0 && u <= 1 && t < nearest) {
+      nearest = t;
+    }
+  }
+  return nearest;
+}
+
+bool particle_filter::update(const float* distances) {
+  bool usable = false;
+  for (int b = 0; b < beam_count; b++) {
+    if (distances[b] > 0 && distances[b] < max_range) { usable = true; }
+  }
+  if (!usable) { return false; }
+
+  float total = 0;
+  for (int i = 0; i < particle_count; i++) {
+    particle& p = particles[i];
+    float sin_heading = sin(to_rad(p.heading));
+    float cos_heading = cos(to_rad(p.heading));
+    float likelihood = 1;
+
+    for (int b = 0; b < beam_count; b++) {
+      if (distances[b] <= 0 || distances[b] >= max_range) { continue; }
+      float sensor_x = p.x + beams[b].x_offset * cos_heading + beams[b].y_offset * sin_heading;
+      float sensor_y = p.y - beams[b].x_offset * sin_heading + beams[b].y_offset * cos_heading;
+      float expected = ray_cast(sensor_x, sensor_y, p.heading + beams[b].angle);
+
+      float sigma = sensor_noise + sensor_noise_scale * expected;
+      float error = (distances[b] - expected) / sigma;
+      likelihood *= exp(-.5 * error * error) + outlier_probability;
+    }
+
+    p.weight *= likelihood;
+    total += p.weight;
+  }
+
+  if (total <= 1e-30) {
+    // Every particle disagreed with the sensors, start the weights over rather than dividing by 0.
+    for (int i = 0; i < particle_count; i++) {
+      particles[i].weight = 1.0 / particle_count;
+    }
+    return true;
+  }
+
+  float squared_sum = 0;
+  for (int i = 0; i < particle_count; i++) {
+    particles[i].weight /= total;
+    squared_sum += particles[i].weight * particles[i].weight;
+  }
+
+  // Resample once fewer than half the particles carry meaningful weight.
+  if (1 / squared_sum < particle_count / 2.0) {
+    resample();
+  }
+  return true;
+}
+
+void particle_filter::resample() {
+  float step = 1.0 / particle_count;
+  float target = uniform() * step;
+  float cumulative = particles[0].weight;
+  int source = 0;
+
+  for (int i = 0; i < particle_count; i++) {
+    while (target > cumulative && source < particle_count - 1) {
+      source++;
+      cumulative += particles[source].weight;
+    }
+    scratch[i] = particles[source];
+    scratch[i].weight = step;
+    target += step;
+  }
+  for (int i = 0; i < particle_count; i++) {
+    particles[i] = scratch[i];
+  }
+}
+
+pose particle_filter::estimate() {
+  float x = 0, y = 0, sin_sum = 0, cos_sum = 0, total = 0;
+  for (int i = 0; i < particle_count; i++) {
+    const particle& p = particles[i];
+    x += p.x * p.weight;
+    y += p.y * p.weight;
+    sin_sum += sin(to_rad(p.heading)) * p.weight;
+    cos_sum += cos(to_rad(p.heading)) * p.weight;
+    total += p.weight;
+  }
+  if (total <= 0) { return {}; }
+
+  pose result;
+  result.x = x / total;
+  result.y = y / total;
+  result.theta = reduce_0_to_360(to_deg(atan2(sin_sum, cos_sum)));
+  return result;
+}
+
+float particle_filter::get_spread() {
+  pose mean = estimate();
+  float variance = 0, total = 0;
+  for (int i = 0; i < particle_count; i++) {
+    const particle& p = particles[i];
+    variance += ((p.x - mean.x) * (p.x - mean.x) + (p.y - mean.y) * (p.y - mean.y)) * p.weight;
+    total += p.weight;
+  }
+  return total > 0 ? sqrt(variance / total) : 0;
+}
+
+float particle_filter::uniform() {
+  // xorshift32, cheap and deterministic so replays are repeatable.
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return (random_state >> 8) * (1.0f / 16777216.0f);
+}
+
+float particle_filter::gaussian() {
+  // Sum of four uniforms has variance 1/3, scaled to 1.
+  return (uniform() + uniform() + uniform() + uniform() - 2) * 1.7320508f;
+}
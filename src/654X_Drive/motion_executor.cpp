@@ -0,0 +1,142 @@
+#include "vex.h"
+
+void cancellation_token::request() {
+  requested = true;
+}
+
+bool cancellation_token::is_requested() {
+  return requested;
+}
+
+void cancellation_token::clear() {
+  requested = false;
+}
+
+motion_executor::motion_executor(int period_ms) :
+  period_ms(period_ms)
+{}
+
+void motion_executor::init() {
+  if (task_started.exchange(true)) { return; }
+
+  control_task = vex::task([](void* self){
+    static_cast<motion_executor*>(self)->control_loop();
+    return 0;
+  }, this);
+}
+
+void motion_executor::start(motion new_motion) {
+  init();
+
+  // The control thread already holds the lock while it runs a motion.
+  bool take_lock = !on_control_thread();
+  if (take_lock) { lock.lock(); }
+  queued_motion = new_motion;
+  motion_queued = true;
+  if (take_lock) { lock.unlock(); }
+}
+
+void motion_executor::cancel(bool hand_off) {
+  bool take_lock = !on_control_thread();
+  if (take_lock) { lock.lock(); }
+  motion_queued = false;
+  queued_motion = motion{};
+  hand_off_requested = hand_off;
+  cancellation.request();
+  if (take_lock) { lock.unlock(); }
+}
+
+bool motion_executor::wait_until_idle(int timeout) {
+  if (on_control_thread()) { return !is_running(); }
+  uint32_t start_time = vex::timer::system();
+  while (is_running() && vex::timer::system() - start_time < (uint32_t)timeout) {
+    vex::this_thread::sleep_for(period_ms);
+  }
+  return !is_running();
+}
+
+bool motion_executor::is_running() {
+  return motion_queued || motion_active;
+}
+
+bool motion_executor::is_handing_off() {
+  return handing_off;
+}
+
+bool motion_executor::on_control_thread() {
+  return task_started && vex::this_thread::get_id() == control_thread_id;
+}
+
+void motion_executor::finish_motion(bool hand_off) {
+  motion_active = false;
+  handing_off = hand_off;
+  if (current_motion.exit) { current_motion.exit(); }
+  handing_off = false;
+  if (on_finish) { on_finish(vex::timer::system() - motion_start_time); }
+  current_motion = motion{};
+}
+
+void motion_executor::lock_motions() {
+  lock.lock();
+}
+
+void motion_executor::unlock_motions() {
+  lock.unlock();
+}
+
+void motion_executor::reset_loop_stats() {
+  max_jitter = 0;
+  average_jitter = 0;
+  overruns = 0;
+  ticks = 0;
+}
+
+void motion_executor::control_loop() {
+  control_thread_id = vex::this_thread::get_id();
+  uint32_t next_tick = vex::timer::system();
+  uint64_t prev_tick_us = vex::timer::systemHighResolution();
+
+  while (1) {
+    uint64_t tick_us = vex::timer::systemHighResolution();
+    dt = (tick_us - prev_tick_us) / 1000.0;
+    prev_tick_us = tick_us;
+
+    float jitter = std::abs(dt - period_ms);
+    max_jitter = std::max(max_jitter, jitter);
+    average_jitter += (jitter - average_jitter) / (ticks + 1);
+    ticks++;
+
+    lock.lock();
+    if (cancellation.is_requested()) {
+      if (motion_active) { finish_motion(hand_off_requested); }
+      hand_off_requested = false;
+      cancellation.clear();
+    }
+    if (motion_queued) {
+      if (motion_active) { finish_motion(true); }
+      current_motion = queued_motion;
+      queued_motion = motion{};
+      motion_queued = false;
+      motion_active = true;
+      motion_start_time = vex::timer::system();
+    }
+    if (motion_active && on_tick) { on_tick(); }
+    if (motion_active && !current_motion.update()) {
+      // A trigger in the last update can start the next motion, which then takes over from this one.
+      finish_motion(motion_queued);
+    }
+    if (!motion_active && !motion_queued && next_motion && next_motion(current_motion)) {
+      motion_active = true;
+      motion_start_time = vex::timer::system();
+    }
+    lock.unlock();
+
+    next_tick += period_ms;
+    if ((int32_t)(next_tick - vex::timer::system()) < 0) {
+      // The tick ran past its slot, start the next one now instead of trying to catch up.
+      overruns++;
+      next_tick = vex::timer::system();
+    }
+    vex::this_thread::sleep_until(next_tick);
+  }
+}
@@ -0,0 +1,96 @@
+#include "vex.h"
+
+motion_profile::motion_profile() {}
+
+motion_profile::motion_profile(float distance, float max_velocity, float max_acceleration, float max_jerk) :
+  direction_sign(distance < 0 ? -1 : 1),
+  max_acceleration(fabs(max_acceleration)),
+  max_jerk(fabs(max_jerk))
+{
+  distance = fabs(distance);
+  max_velocity = fabs(max_velocity);
+  this->distance = distance;
+  if (distance == 0 || max_velocity == 0 || this->max_acceleration == 0) { return; }
+
+  float jerk_time, accel_time, peak_acceleration;
+  float peak_velocity = max_velocity;
+  float ramp_distance = speed_up_distance(peak_velocity, jerk_time, accel_time, peak_acceleration);
+
+  if (2 * ramp_distance > distance) {
+    // Not enough room to reach max velocity, bisect for the highest velocity that still fits.
+    float low = 0;
+    float high = max_velocity;
+    for (int i = 0; i < 30; i++) {
+      float mid = (low + high) / 2;
+      if (2 * speed_up_distance(mid, jerk_time, accel_time, peak_acceleration) > distance) {
+        high = mid;
+      } else {
+        low = mid;
+      }
+    }
+    peak_velocity = low;
+    ramp_distance = speed_up_distance(peak_velocity, jerk_time, accel_time, peak_acceleration);
+  }
+
+  float cruise_time = (distance - 2 * ramp_distance) / peak_velocity;
+  float jerk = jerk_time > 0 ? peak_acceleration / jerk_time : 0;
+
+  const float durations[7] = { jerk_time, accel_time, jerk_time, cruise_time, jerk_time, accel_time, jerk_time };
+  const float accelerations[7] = { 0, peak_acceleration, peak_acceleration, 0, 0, -peak_acceleration, -peak_acceleration };
+  const float jerks[7] = { jerk, 0, -jerk, 0, -jerk, 0, jerk };
+
+  float position = 0;
+  float velocity = 0;
+  for (int i = 0; i < 7; i++) {
+    float t = durations[i];
+    float a = accelerations[i];
+    float j = jerks[i];
+    phases[i] = { t, position, velocity, a, j };
+
+    position += velocity * t + a * t * t / 2 + j * t * t * t / 6;
+    velocity += a * t + j * t * t / 2;
+    duration += t;
+  }
+}
+
+float motion_profile::speed_up_distance(float velocity, float& jerk_time, float& accel_time, float& peak_acceleration) {
+  if (max_jerk == 0) {
+    jerk_time = 0;
+    peak_acceleration = max_acceleration;
+    accel_time = velocity / max_acceleration;
+  } else if (velocity * max_jerk >= max_acceleration * max_acceleration) {
+    jerk_time = max_acceleration / max_jerk;
+    peak_acceleration = max_acceleration;
+    accel_time = velocity / max_acceleration - jerk_time;
+  } else {
+    // Max acceleration is never reached, the jerk phases meet in the middle.
+    jerk_time = sqrt(velocity / max_jerk);
+    peak_acceleration = max_jerk * jerk_time;
+    accel_time = 0;
+  }
+  // Speeding up is symmetric about half of the final velocity.
+  return velocity * (2 * jerk_time + accel_time) / 2;
+}
+
+profile_point motion_profile::sample(float time) {
+  if (time >= duration) { return { direction_sign * distance, 0, 0 }; }
+  time = std::max(time, 0.0f);
+
+  int i = 0;
+  while (i < 6 && time > phases[i].duration) {
+    time -= phases[i].duration;
+    i++;
+  }
+  time = std::min(time, phases[i].duration);
+
+  const phase& ph = phases[i];
+  float position = ph.position + ph.velocity * time + ph.acceleration * time * time / 2 + ph.jerk * time * time * time / 6;
+  float velocity = ph.velocity + ph.acceleration * time + ph.jerk * time * time / 2;
+  float acceleration = ph.acceleration + ph.jerk * time;
+
+  return { direction_sign * position, direction_sign * velocity, direction_sign * acceleration };
+}
+
+float motion_profile::get_duration() {
+  return duration;
+}
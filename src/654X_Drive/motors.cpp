@@ -51,14 +51,16 @@ void mik::motor_group::setTimeout(int32_t time, vex::timeUnits units) {
 }
 
 void mik::motor_group::spin(vex::directionType dir) {
+    float voltage = compensate(set_voltage);
     for (mik::motor& motor : motors) {
-        motor.spin(dir, set_voltage, vex::voltageUnits::volt);
+        motor.spin(dir, voltage, vex::voltageUnits::volt);
     }
 }
 
 void mik::motor_group::spin(vex::directionType dir, float voltage, vex::voltageUnits units) {
+    voltage = compensate(to_volt(voltage, units));
     for (mik::motor& motor : motors) {
-        motor.spin(dir, voltage, units);
+        motor.spin(dir, voltage, vex::voltageUnits::volt);
     }
 }
 
@@ -112,7 +114,7 @@ struct SpinCtx {
 void mik::motor_group::spinFor(float time, vex::timeUnits units, float voltage, vex::voltageUnits units_v, bool waitForCompletion) {
     if (motors.empty()) { return; }
 
-    SpinCtx* ctx = new SpinCtx{this, vex::directionType::undefined, time, units, voltage, units_v};
+    SpinCtx* ctx = new SpinCtx{this, vex::directionType::undefined, time, units, compensate(to_volt(voltage, units_v)), vex::voltageUnits::volt};
     int (*spin)(void*) = [](void* raw){ 
         auto* ctx = static_cast<SpinCtx*>(raw);
         for (auto& motor : ctx->self->getMotors()) {
@@ -133,7 +135,7 @@ void mik::motor_group::spinFor(float time, vex::timeUnits units, float voltage,
 void mik::motor_group::spinFor(vex::directionType dir, float time, vex::timeUnits units, float voltage, vex::voltageUnits units_v, bool waitForCompletion) {
     if (motors.empty()) { return; }
 
-    SpinCtx* ctx = new SpinCtx{this, dir, time, units, voltage, units_v};
+    SpinCtx* ctx = new SpinCtx{this, dir, time, units, compensate(to_volt(voltage, units_v)), vex::voltageUnits::volt};
     int (*spin)(void*) = [](void* raw){ 
         auto* ctx = static_cast<SpinCtx*>(raw);
         for (auto& motor : ctx->self->getMotors()) {
@@ -206,6 +208,19 @@ float mik::motor_group::position(vex::rotationUnits units) {
     return motors[0].position(units);
 }
 
+float mik::motor_group::velocity(vex::velocityUnits units) {
+    if (motors.empty()) { return 0; }
+    return motors[0].velocity(units);
+}
+
+float mik::motor_group::averageVelocity(vex::velocityUnits units) {
+    float velocity = 0;
+    for (mik::motor& motor : motors) {
+        velocity += motor.velocity(units);
+    }
+    return velocity / motors.size();
+}
+
 float mik::motor_group::voltage(vex::voltageUnits units) {
     if (motors.empty()) { return 0; }
     return motors[0].voltage(units);
@@ -320,4 +335,41 @@ float mik::motor_group::to_volt(float voltage, vex::voltageUnits velocityUnits)
 
 std::vector<mik::motor>& mik::motor_group::getMotors() {
     return motors;
+}
+
+void mik::motor_group::setVoltageCompensation(bool enabled, float nominal_voltage) {
+    compensation_enabled = enabled;
+    this->nominal_voltage = nominal_voltage;
+    compensation_ratio = 1;
+}
+
+float mik::motor_group::compensationRatio(void) {
+    return compensation_ratio;
+}
+
+float mik::motor_group::compensate(float voltage) {
+    if (!compensation_enabled) { return voltage; }
+
+    float battery_voltage = filtered_battery_voltage();
+    // A missing or glitched reading shouldn't double every output, so the ratio is kept near 1.
+    compensation_ratio = battery_voltage > 0 ? clamp(nominal_voltage / battery_voltage, .8, 1.25) : 1;
+    return clamp(voltage * compensation_ratio, -12, 12);
+}
+
+float mik::filtered_battery_voltage(void) {
+    static float filtered = 0;
+    static uint32_t last_read = 0;
+    const float time_constant_ms = 500;
+
+    uint32_t now = vex::timer::system();
+    if (filtered == 0) {
+        filtered = Brain.Battery.voltage(vex::voltageUnits::volt);
+        last_read = now;
+    } else if (now != last_read) {
+        // Several groups spin every tick, only the first one each millisecond reads the battery.
+        float elapsed = now - last_read;
+        filtered += elapsed / (time_constant_ms + elapsed) * (Brain.Battery.voltage(vex::voltageUnits::volt) - filtered);
+        last_read = now;
+    }
+    return filtered;
 }
\ No newline at end of file
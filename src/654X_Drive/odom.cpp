@@ -12,7 +12,97 @@ void odom::set_position(point position, float orientation_deg, float ForwardTrac
   this->orientation_deg = orientation_deg;
 }
 
+void odom::set_position_ticks(point position, double orientation_deg, int32_t ForwardTracker_ticks, int32_t SidewaysTracker_ticks, double ForwardTracker_inch_per_tick, double SidewaysTracker_inch_per_tick){
+  this->ForwardTracker_ticks = ForwardTracker_ticks;
+  this->SidewaysTracker_ticks = SidewaysTracker_ticks;
+  this->ForwardTracker_inch_per_tick = ForwardTracker_inch_per_tick;
+  this->SidewaysTracker_inch_per_tick = SidewaysTracker_inch_per_tick;
+  this->position = position;
+  this->orientation_deg = orientation_deg;
+  precise_orientation_deg = orientation_deg;
+  compensation = {0, 0};
+}
+
+/** @brief Adds value to sum, carrying the part that didn't fit in compensation for next time. */
+static void kahan_add(double& sum, double& compensation, double value) {
+  double corrected = value - compensation;
+  double total = sum + corrected;
+  compensation = (total - sum) - corrected;
+  sum = total;
+}
+
+void odom::update_position_ticks(int32_t ForwardTracker_ticks, int32_t SidewaysTracker_ticks, double orientation_deg){
+  double Forward_delta = (ForwardTracker_ticks - this->ForwardTracker_ticks) * ForwardTracker_inch_per_tick;
+  double Sideways_delta = (SidewaysTracker_ticks - this->SidewaysTracker_ticks) * SidewaysTracker_inch_per_tick;
+  this->ForwardTracker_ticks = ForwardTracker_ticks;
+  this->SidewaysTracker_ticks = SidewaysTracker_ticks;
+  double prev_orientation_rad = precise_orientation_deg * (M_PI / 180);
+  double orientation_delta_rad = (orientation_deg - precise_orientation_deg) * (M_PI / 180);
+  precise_orientation_deg = orientation_deg;
+  this->orientation_deg = orientation_deg;
+
+  if (orientation_delta_rad > M_PI) { orientation_delta_rad -= 2 * M_PI; }
+  if (orientation_delta_rad < -M_PI) { orientation_delta_rad += 2 * M_PI; }
+
+  double chord, chord_ratio;
+  if (fabs(orientation_delta_rad) < 1e-6) {
+    chord_ratio = 1 - orientation_delta_rad * orientation_delta_rad / 24;
+    chord = orientation_delta_rad * chord_ratio;
+  } else {
+    chord = 2 * sin(orientation_delta_rad / 2);
+    chord_ratio = chord / orientation_delta_rad;
+  }
+
+  double local_X_position = Sideways_delta * chord_ratio + SidewaysTracker_center_distance * chord;
+  double local_Y_position = Forward_delta * chord_ratio + ForwardTracker_center_distance * chord;
+
+  double mid = prev_orientation_rad + orientation_delta_rad / 2;
+  double sin_mid = sin(mid);
+  double cos_mid = cos(mid);
+  kahan_add(position.x, compensation.x, local_X_position * cos_mid + local_Y_position * sin_mid);
+  kahan_add(position.y, compensation.y, local_Y_position * cos_mid - local_X_position * sin_mid);
+}
+
 void odom::update_position(float ForwardTracker_position, float SidewaysTracker_position, float orientation_deg){
+  const float deg_to_rad = 0.017453293f;
+  float Forward_delta = ForwardTracker_position - this->ForwardTracker_position;
+  float Sideways_delta = SidewaysTracker_position - this->SideWaysTracker_position;
+  this->ForwardTracker_position = ForwardTracker_position;
+  this->SideWaysTracker_position = SidewaysTracker_position;
+  float prev_orientation_rad = this->orientation_deg * deg_to_rad;
+  float orientation_delta_rad = (orientation_deg - this->orientation_deg) * deg_to_rad;
+  this->orientation_deg = orientation_deg;
+
+  // Headings come in as 0-360, so crossing 0 would otherwise look like a full turn.
+  if (orientation_delta_rad > (float)M_PI) { orientation_delta_rad -= 2 * (float)M_PI; }
+  if (orientation_delta_rad < -(float)M_PI) { orientation_delta_rad += 2 * (float)M_PI; }
+
+  // chord = 2 * sin(delta / 2) is the straight-line length of the arc per unit of radius,
+  // and chord_ratio = chord / delta scales the tracker deltas onto that chord.
+  float half_delta = orientation_delta_rad / 2;
+  float chord, chord_ratio;
+  if (fabsf(orientation_delta_rad) < 1e-3f) {
+    float delta_squared = orientation_delta_rad * orientation_delta_rad;
+    chord_ratio = 1 - delta_squared / 24;
+    chord = orientation_delta_rad * chord_ratio;
+  } else {
+    float sin_half, cos_half;
+    fast_sin_cos(half_delta, sin_half, cos_half);
+    chord = 2 * sin_half;
+    chord_ratio = chord / orientation_delta_rad;
+  }
+
+  float local_X_position = Sideways_delta * chord_ratio + SidewaysTracker_center_distance * chord;
+  float local_Y_position = Forward_delta * chord_ratio + ForwardTracker_center_distance * chord;
+
+  // Rotate the local displacement into field coordinates by the average heading over the update.
+  float sin_mid, cos_mid;
+  fast_sin_cos(prev_orientation_rad + half_delta, sin_mid, cos_mid);
+  position.x += local_X_position * cos_mid + local_Y_position * sin_mid;
+  position.y += local_Y_position * cos_mid - local_X_position * sin_mid;
+}
+
+void odom::update_position_polar(float ForwardTracker_position, float SidewaysTracker_position, float orientation_deg){
   float Forward_delta = ForwardTracker_position - this->ForwardTracker_position;
   float Sideways_delta = SidewaysTracker_position - this->SideWaysTracker_position;
   this->ForwardTracker_position = ForwardTracker_position;
@@ -21,6 +111,10 @@ void odom::update_position(float ForwardTracker_position, float SidewaysTracker_
   float prev_orientation_rad = to_rad(this->orientation_deg);
   float orientation_delta_rad = orientation_rad-prev_orientation_rad;
   this->orientation_deg = orientation_deg;
+
+  // Headings come in as 0-360, so crossing 0 would otherwise look like a full turn.
+  if (orientation_delta_rad > (float)M_PI) { orientation_delta_rad -= 2 * (float)M_PI; }
+  if (orientation_delta_rad < -(float)M_PI) { orientation_delta_rad += 2 * (float)M_PI; }
   
   float local_X_position;
   float local_Y_position;
@@ -0,0 +1,215 @@
+#include "vex.h"
+
+std::vector<point> resample_path(const std::vector<point>& path, float spacing) {
+  std::vector<point> resampled = {};
+  if (path.empty()) { return resampled; }
+
+  resampled.push_back(path[0]);
+  float leftover = 0; // Distance already covered towards the next sample on the previous segments.
+
+  for (size_t i = 0; i < path.size() - 1; i++) {
+    point start = path[i];
+    point end = path[i+1];
+    float length = dist(start, end);
+    if (length < 1e-4) { continue; }
+
+    float along = spacing - leftover;
+    while (along <= length) {
+      float t = along / length;
+      resampled.push_back({ start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t });
+      along += spacing;
+    }
+    leftover = length - (along - spacing);
+  }
+
+  if (dist(resampled.back(), path.back()) > 1e-4) {
+    resampled.push_back(path.back());
+  }
+  return resampled;
+}
+
+float path_curvature(point p1, point p2, point p3) {
+  float a = dist(p1, p2);
+  float b = dist(p2, p3);
+  float c = dist(p1, p3);
+  float cross = (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+  if (a * b * c < 1e-6) { return 0; }
+
+  // Circumcircle radius is abc / 4*area, and |cross| is twice the area.
+  return 2 * fabs(cross) / (a * b * c);
+}
+
+std::vector<path_point> profile_path(const std::vector<point>& path, float spacing, float max_velocity, float max_acceleration, float max_lateral_acceleration) {
+  std::vector<point> resampled = resample_path(path, spacing);
+  std::vector<path_point> profiled(resampled.size());
+  if (resampled.empty()) { return profiled; }
+
+  // Resampled points sit on straight segments, so curvature is measured across a few inches
+  // of path instead of between neighbours, otherwise it spikes at every original waypoint.
+  int window = std::max(1, (int)round(3 / spacing));
+  int last = resampled.size() - 1;
+
+  for (int i = 0; i <= last; i++) {
+    profiled[i].position = resampled[i];
+    if (i > 0) {
+      profiled[i].distance = profiled[i-1].distance + dist(resampled[i-1], resampled[i]);
+    }
+    if (i > 0 && i < last) {
+      profiled[i].curvature = path_curvature(resampled[std::max(0, i - window)], resampled[i], resampled[std::min(last, i + window)]);
+    }
+
+    // v^2 * curvature is the acceleration needed to hold the curve.
+    float velocity = max_velocity;
+    if (profiled[i].curvature > 0) {
+      velocity = std::min(velocity, (float)sqrt(max_lateral_acceleration / profiled[i].curvature));
+    }
+    profiled[i].velocity = velocity;
+  }
+
+  // Backwards pass, brake in time for every curve and come to rest on the last point.
+  profiled.back().velocity = 0;
+  for (int i = profiled.size() - 2; i >= 0; i--) {
+    float d = profiled[i+1].distance - profiled[i].distance;
+    float reachable = sqrt(profiled[i+1].velocity * profiled[i+1].velocity + 2 * max_acceleration * d);
+    profiled[i].velocity = std::min(profiled[i].velocity, reachable);
+  }
+
+  // Forwards pass, speed up from rest at the first point.
+  profiled[0].velocity = 0;
+  for (size_t i = 1; i < profiled.size(); i++) {
+    float d = profiled[i].distance - profiled[i-1].distance;
+    float reachable = sqrt(profiled[i-1].velocity * profiled[i-1].velocity + 2 * max_acceleration * d);
+    profiled[i].velocity = std::min(profiled[i].velocity, reachable);
+  }
+
+  for (size_t i = 0; i < profiled.size() - 1; i++) {
+    float d = profiled[i+1].distance - profiled[i].distance;
+    if (d > 0) {
+      profiled[i].acceleration = (profiled[i+1].velocity * profiled[i+1].velocity - profiled[i].velocity * profiled[i].velocity) / (2 * d);
+    }
+  }
+
+  return profiled;
+}
+
+int line_circle_intersections(point center, float radius, point p1, point p2, point out[2], float out_t[2]) {
+  double dx = p2.x - p1.x;
+  double dy = p2.y - p1.y;
+  double fx = p1.x - center.x;
+  double fy = p1.y - center.y;
+
+  double a = dx * dx + dy * dy;
+  double b = 2 * (fx * dx + fy * dy);
+  double c = fx * fx + fy * fy - radius * radius;
+  double discriminant = b * b - 4 * a * c;
+  if (a < 1e-9 || discriminant < 0) { return 0; }
+
+  double root = sqrt(discriminant);
+  double solutions[2] = { (-b - root) / (2 * a), (-b + root) / (2 * a) };
+
+  int count = 0;
+  for (double t : solutions) {
+    if (t < 0 || t > 1) { continue; }
+    out[count] = { p1.x + dx * t, p1.y + dy * t };
+    if (out_t) { out_t[count] = t; }
+    count++;
+  }
+  return count;
+}
+
+pursuit_lookahead::pursuit_lookahead(int window) :
+  window(window)
+{}
+
+void pursuit_lookahead::reset() {
+  segment = 0;
+  segment_t = 0;
+}
+
+bool pursuit_lookahead::find(const std::vector<point>& path, point position, float radius, point& target) {
+  if (path.size() < 2) { return false; }
+
+  // Segments that are entirely inside the circle can't be intersected, skip past them.
+  while (segment < path.size() - 2 && dist(position, path[segment+1]) <= radius) {
+    segment++;
+    segment_t = 0;
+  }
+
+  size_t last_segment = std::min(path.size() - 1, segment + window);
+  point intersections[2];
+  float t[2];
+  bool found = false;
+
+  for (size_t i = segment; i < last_segment; i++) {
+    int count = line_circle_intersections(position, radius, path[i], path[i+1], intersections, t);
+    for (int j = 0; j < count; j++) {
+      // Later segments and points further along a segment are always better, as long as they aren't behind the cursor.
+      if (i == segment && t[j] < segment_t) { continue; }
+      target = intersections[j];
+      segment = i;
+      segment_t = t[j];
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool pursuit_lookahead::is_finished(const std::vector<point>& path, point position, float radius) {
+  if (path.size() < 2) { return true; }
+  if (segment < path.size() - 2) { return false; }
+  return dist(position, path.back()) <= radius;
+}
+
+std::vector<trajectory_point> generate_trajectory(const std::vector<point>& path, float spacing, float max_velocity, float max_acceleration, float max_lateral_acceleration) {
+  std::vector<path_point> profiled = profile_path(path, spacing, max_velocity, max_acceleration, max_lateral_acceleration);
+  std::vector<trajectory_point> trajectory(profiled.size());
+  if (profiled.size() < 2) { return trajectory; }
+
+  for (size_t i = 0; i < profiled.size(); i++) {
+    // Heading follows the path tangent, the last point keeps the direction it was approached from.
+    size_t from = i < profiled.size() - 1 ? i : i - 1;
+    point a = profiled[from].position;
+    point b = profiled[from + 1].position;
+
+    trajectory[i].position = profiled[i].position;
+    trajectory[i].heading = reduce_0_to_360(to_deg(atan2(b.x - a.x, b.y - a.y)));
+    trajectory[i].velocity = profiled[i].velocity;
+    trajectory[i].acceleration = profiled[i].acceleration;
+
+    if (i > 0) {
+      // Constant acceleration between points, so the average velocity is the mean of both ends.
+      float d = profiled[i].distance - profiled[i-1].distance;
+      float v = profiled[i-1].velocity + profiled[i].velocity;
+      float dt = v > 0 ? 2 * d / v : 0;
+      trajectory[i].time = trajectory[i-1].time + dt;
+      if (dt > 0) {
+        trajectory[i-1].angular_velocity = reduce_negative_180_to_180(trajectory[i].heading - trajectory[i-1].heading) / dt;
+      }
+    }
+  }
+  return trajectory;
+}
+
+trajectory_point sample_trajectory(const std::vector<trajectory_point>& trajectory, float time, size_t& index) {
+  if (trajectory.empty()) { return {}; }
+  if (time <= trajectory.front().time) { index = 0; return trajectory.front(); }
+  if (time >= trajectory.back().time) { index = trajectory.size() - 1; return trajectory.back(); }
+
+  if (index >= trajectory.size() || trajectory[index].time > time) { index = 0; }
+  while (index < trajectory.size() - 2 && trajectory[index + 1].time <= time) {
+    index++;
+  }
+
+  const trajectory_point& a = trajectory[index];
+  const trajectory_point& b = trajectory[index + 1];
+  float t = b.time > a.time ? (time - a.time) / (b.time - a.time) : 0;
+
+  trajectory_point sample;
+  sample.time = time;
+  sample.position = { a.position.x + (b.position.x - a.position.x) * t, a.position.y + (b.position.y - a.position.y) * t };
+  sample.heading = reduce_0_to_360(a.heading + reduce_negative_180_to_180(b.heading - a.heading) * t);
+  sample.velocity = a.velocity + (b.velocity - a.velocity) * t;
+  sample.acceleration = a.acceleration;
+  sample.angular_velocity = a.angular_velocity;
+  return sample;
+}
@@ -0,0 +1,104 @@
+#include "vex.h"
+
+void pose_seqlock::publish(float x, float y, float theta, uint32_t timestamp) {
+  uint32_t seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  this->x.store(x, std::memory_order_relaxed);
+  this->y.store(y, std::memory_order_relaxed);
+  this->theta.store(theta, std::memory_order_relaxed);
+  this->timestamp.store(timestamp, std::memory_order_relaxed);
+
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+pose pose_seqlock::read() const {
+  pose snapshot;
+  uint32_t start_seq, end_seq;
+  do {
+    start_seq = sequence.load(std::memory_order_acquire);
+    if (start_seq & 1) {
+      // The odom task is partway through a write, let it finish.
+      vex::this_thread::yield();
+      continue;
+    }
+    snapshot.x = x.load(std::memory_order_relaxed);
+    snapshot.y = y.load(std::memory_order_relaxed);
+    snapshot.theta = theta.load(std::memory_order_relaxed);
+    snapshot.timestamp = timestamp.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    end_seq = sequence.load(std::memory_order_relaxed);
+  } while ((start_seq & 1) || start_seq != end_seq);
+
+  // Two sequence steps per publish.
+  snapshot.seq = start_seq / 2;
+  return snapshot;
+}
+
+void pose_history::push(const pose& p) {
+  lock.lock();
+  if (count > 0 && p.timestamp < at(count - 1).timestamp) {
+    lock.unlock();
+    return;
+  }
+  poses[head] = p;
+  head = (head + 1) % capacity;
+  if (count < capacity) { count++; }
+  lock.unlock();
+}
+
+void pose_history::clear() {
+  lock.lock();
+  head = 0;
+  count = 0;
+  lock.unlock();
+}
+
+size_t pose_history::size() {
+  lock.lock();
+  size_t stored = count;
+  lock.unlock();
+  return stored;
+}
+
+const pose& pose_history::at(size_t i) const {
+  return poses[(head + capacity - count + i) % capacity];
+}
+
+bool pose_history::sample(uint32_t timestamp, pose& result) {
+  lock.lock();
+  if (count == 0 || timestamp < at(0).timestamp) {
+    lock.unlock();
+    return false;
+  }
+  if (timestamp >= at(count - 1).timestamp) {
+    result = at(count - 1);
+    lock.unlock();
+    return true;
+  }
+
+  // Find the last pose at or before timestamp, the one after it is strictly later.
+  size_t low = 0;
+  size_t high = count - 1;
+  while (high - low > 1) {
+    size_t mid = (low + high) / 2;
+    if (at(mid).timestamp <= timestamp) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+
+  pose a = at(low);
+  pose b = at(high);
+  lock.unlock();
+
+  float t = b.timestamp > a.timestamp ? (float)(timestamp - a.timestamp) / (b.timestamp - a.timestamp) : 0;
+  result.x = a.x + (b.x - a.x) * t;
+  result.y = a.y + (b.y - a.y) * t;
+  result.theta = reduce_0_to_360(a.theta + reduce_negative_180_to_180(b.theta - a.theta) * t);
+  result.timestamp = timestamp;
+  result.seq = a.seq;
+  return true;
+}
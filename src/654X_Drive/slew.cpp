@@ -0,0 +1,33 @@
+#include "vex.h"
+
+slew_limiter::slew_limiter(float accelerate_rate, float decelerate_rate) :
+  accelerate_rate(accelerate_rate),
+  decelerate_rate(decelerate_rate)
+{}
+
+float slew_limiter::limit(float target, float dt) {
+  float seconds = dt / 1000;
+  float output_size = fabs(output);
+  float target_size = fabs(target);
+  bool same_side = (output >= 0 && target >= 0) || (output <= 0 && target <= 0);
+
+  // Slowing down covers the part of the change between the output and 0.
+  float towards_zero = same_side ? std::max(output_size - target_size, 0.0f) : output_size;
+  if (decelerate_rate > 0 && towards_zero > decelerate_rate * seconds) {
+    output -= sign(output) * decelerate_rate * seconds;
+    return output;
+  }
+
+  // Speeding up covers the rest, starting from 0 when the sign changes.
+  float start = same_side ? std::min(output_size, target_size) : 0;
+  if (accelerate_rate > 0 && target_size - start > accelerate_rate * seconds) {
+    output = sign(target) * (start + accelerate_rate * seconds);
+    return output;
+  }
+  output = target;
+  return output;
+}
+
+void slew_limiter::reset(float output) {
+  this->output = output;
+}
@@ -34,28 +34,47 @@ float to_deg(float angle_rad) {
   return (angle_rad * (180.0 / M_PI));
 }
 
-float reduce_negative_180_to_180(float angle) {
-  while(!(angle >= -180 && angle < 180)) {
-    if(angle < -180) { angle += 360; }
-    if(angle >= 180) { angle -= 360; }
+void fast_sin_cos(float angle_rad, float& sin_out, float& cos_out) {
+  // Nearest multiple of 90 degrees, with pi/2 split in two so the subtraction stays exact.
+  float quadrant = floorf(angle_rad * 0.63661977f + .5f);
+  float r = (angle_rad - quadrant * 1.5703125f) - quadrant * 4.8382679e-4f;
+  float r2 = r * r;
+
+  float s = r + r * r2 * (-1.6666667e-1f + r2 * (8.3333333e-3f + r2 * -1.9841270e-4f));
+  float c = 1 + r2 * (-.5f + r2 * (4.1666667e-2f + r2 * (-1.3888889e-3f + r2 * 2.4801587e-5f)));
+
+  switch ((int)quadrant & 3) {
+    case 0: sin_out = s; cos_out = c; break;
+    case 1: sin_out = c; cos_out = -s; break;
+    case 2: sin_out = -s; cos_out = -c; break;
+    default: sin_out = -c; cos_out = s; break;
   }
-  return angle;
+}
+
+// The reductions below take the same time for any heading a robot will reach. One floor finds how many turns
+// to take off, and the selects afterwards catch results that rounded onto a range edge,
+// which the compiler turns into conditional moves rather than branches. Past 2^24 degrees the
+// turn count stops rounding cleanly, so those angles are first brought in with fmodf, which is exact.
+
+float reduce_negative_180_to_180(float angle) {
+  if (fabsf(angle) >= 16777216) { angle = fmodf(angle, 360); }
+  float reduced = angle - 360 * floorf((angle + 180) * (1.0f / 360));
+  reduced = reduced < -180 ? reduced + 360 : reduced;
+  return reduced >= 180 ? reduced - 360 : reduced;
 }
 
 float reduce_negative_90_to_90(float angle) {
-  while(!(angle >= -90 && angle < 90)) {
-    if(angle < -90) { angle += 180; }
-    if(angle >= 90) { angle -= 180; }
-  }
-  return angle;
+  if (fabsf(angle) >= 16777216) { angle = fmodf(angle, 180); }
+  float reduced = angle - 180 * floorf((angle + 90) * (1.0f / 180));
+  reduced = reduced < -90 ? reduced + 180 : reduced;
+  return reduced >= 90 ? reduced - 180 : reduced;
 }
 
 float reduce_0_to_360(float angle) {
-  while(!(angle >= 0 && angle < 360)) {
-    if(angle < 0) { angle += 360; }
-    if(angle >= 360) { angle -= 360; }
-  }
-  return angle;
+  if (fabsf(angle) >= 16777216) { angle = fmodf(angle, 360); }
+  float reduced = angle - 360 * floorf(angle * (1.0f / 360));
+  reduced = reduced < 0 ? reduced + 360 : reduced;
+  return reduced >= 360 ? reduced - 360 : reduced;
 }
 
 float mirror_angle(float angle, bool mirror) { 
@@ -95,14 +114,34 @@ float angle_error(float error, direction dir) {
   switch (dir)
   {
   case direction::CW:
-    return error < 0 ? error + 360 : error;
+    return reduce_0_to_360(error);
     case direction::CCW:
-    return error > 0 ? error - 360 : error;
+    return -reduce_0_to_360(-error);
     case direction::FASTEST:
     return reduce_negative_180_to_180(error);
   }
 }
 
+unwrapped_heading::unwrapped_heading(float degrees) :
+  degrees(degrees)
+{}
+
+float unwrapped_heading::unwrapped() const {
+  return degrees;
+}
+
+float unwrapped_heading::wrapped() const {
+  return reduce_0_to_360(degrees);
+}
+
+float unwrapped_heading::error_to(float target_deg, direction dir) const {
+  return angle_error(target_deg - degrees, dir);
+}
+
+float unwrapped_heading::turned_since(const unwrapped_heading& previous) const {
+  return degrees - previous.degrees;
+}
+
 bool is_line_settled(float desired_X, float desired_Y, float desired_angle_deg, float current_X, float current_Y){
   return (desired_Y - current_Y) * cos(to_rad(desired_angle_deg)) <= -(desired_X - current_X) * sin(to_rad(desired_angle_deg));
 }
@@ -99,7 +99,7 @@ void UI_auton_screen::exit_auton_task() {
         if (Controller.ButtonB.pressing()) {
             task::sleep(200);
             auton_scr->auto_running = false;
-            auton_scr->auton_run.stop();
+            chassis.stop_motion_task(auton_scr->auton_run);
             chassis.stop_drive(vex::brakeType::hold);
             assembly.stop_motors(vex::brakeType::hold);
             task::sleep(500);
@@ -116,7 +116,7 @@ void UI_auton_screen::exit_auton_task() {
 void UI_auton_screen::end_auton() {
     disable_controller_overlay();
     auto_running = false;
-    auton_run.stop();
+    chassis.stop_motion_task(auton_run);
 }
 
 void UI_auton_screen::UI_crt_auton_scr() {
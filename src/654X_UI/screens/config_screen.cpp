@@ -23,7 +23,7 @@ std::shared_ptr<screen> UI_config_screen::get_config_screen() {
 }
 
 void UI_config_screen::UI_crt_config_scr() {
-    UI_config_scr = UI_crt_scr(0, 45, SCREEN_WIDTH, SCREEN_HEIGHT + 5);
+    UI_config_scr = UI_crt_scr(0, 45, SCREEN_WIDTH, SCREEN_HEIGHT + 161);
     UI_config_scr->add_scroll_bar(UI_crt_rec(0, 0, 3, 40, 0x00434343, UI_distance_units::pixels), screen::alignment::RIGHT);
     auto bg = UI_crt_bg(UI_crt_rec(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, vex::color::black, UI_distance_units::pixels));
 
@@ -114,6 +114,46 @@ void UI_config_screen::UI_crt_config_scr() {
         macro_18_bg->set_states(UI_crt_rec(322, 91+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(322, 91+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
     auto macro_18 = UI_crt_txtbox("test_slot_6", text_alignment, UI_crt_rec(324, 93+39+39+39+39, 150, 31, test_slot_color, UI_distance_units::pixels));
 
+    auto macro_19_bg = UI_crt_btn(UI_crt_rec(4, 91+39+39+39+39+39, 154, 35, macro_slot_border_color, UI_distance_units::pixels), [](){ config_benchmark_lookahead(); });
+    macro_19_bg->set_states(UI_crt_rec(4, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(4, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_19 = UI_crt_txtbox("Lookahead Bench", text_alignment, UI_crt_rec(6, 93+39+39+39+39+39, 150, 31, macro_slot_color, UI_distance_units::pixels));
+
+    auto macro_20_bg = UI_crt_btn(UI_crt_rec(163, 91+39+39+39+39+39, 154, 35, data_slot_border_color, UI_distance_units::pixels), [](){ config_replay_odom_log(); });
+        macro_20_bg->set_states(UI_crt_rec(163, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(163, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_20 = UI_crt_txtbox("Replay Odom", text_alignment, UI_crt_rec(165, 93+39+39+39+39+39, 150, 31, data_slot_color, UI_distance_units::pixels));
+
+    auto macro_21_bg = UI_crt_btn(UI_crt_rec(322, 91+39+39+39+39+39, 154, 35, test_slot_border_color, UI_distance_units::pixels), [](){ config_benchmark_odom(); });
+        macro_21_bg->set_states(UI_crt_rec(322, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(322, 91+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_21 = UI_crt_txtbox("Bench Odom", text_alignment, UI_crt_rec(324, 93+39+39+39+39+39, 150, 31, test_slot_color, UI_distance_units::pixels));
+
+    auto macro_22_bg = UI_crt_btn(UI_crt_rec(4, 91+39+39+39+39+39+39, 154, 35, macro_slot_border_color, UI_distance_units::pixels), [](){ config_benchmark_odom_precision(); });
+    macro_22_bg->set_states(UI_crt_rec(4, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(4, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_22 = UI_crt_txtbox("Odom Precision", text_alignment, UI_crt_rec(6, 93+39+39+39+39+39+39, 150, 31, macro_slot_color, UI_distance_units::pixels));
+
+    auto macro_23_bg = UI_crt_btn(UI_crt_rec(163, 91+39+39+39+39+39+39, 154, 35, data_slot_border_color, UI_distance_units::pixels), [](){ config_settle_report(); });
+        macro_23_bg->set_states(UI_crt_rec(163, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(163, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_23 = UI_crt_txtbox("Settle Report", text_alignment, UI_crt_rec(165, 93+39+39+39+39+39+39, 150, 31, data_slot_color, UI_distance_units::pixels));
+
+    auto macro_24_bg = UI_crt_btn(UI_crt_rec(322, 91+39+39+39+39+39+39, 154, 35, test_slot_border_color, UI_distance_units::pixels), [](){ config_compare_slew(); });
+        macro_24_bg->set_states(UI_crt_rec(322, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(322, 91+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_24 = UI_crt_txtbox("Compare Slew", text_alignment, UI_crt_rec(324, 93+39+39+39+39+39+39, 150, 31, test_slot_color, UI_distance_units::pixels));
+
+    auto macro_25_bg = UI_crt_btn(UI_crt_rec(4, 91+39+39+39+39+39+39+39, 154, 35, macro_slot_border_color, UI_distance_units::pixels), [](){ config_test_motion_queue(); });
+    macro_25_bg->set_states(UI_crt_rec(4, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(4, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_25 = UI_crt_txtbox("Motion Queue", text_alignment, UI_crt_rec(6, 93+39+39+39+39+39+39+39, 150, 31, macro_slot_color, UI_distance_units::pixels));
+
+    auto macro_26_bg = UI_crt_btn(UI_crt_rec(163, 91+39+39+39+39+39+39+39, 154, 35, data_slot_border_color, UI_distance_units::pixels), [](){ config_benchmark_angles(); });
+        macro_26_bg->set_states(UI_crt_rec(163, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(163, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_26 = UI_crt_txtbox("Bench Angles", text_alignment, UI_crt_rec(165, 93+39+39+39+39+39+39+39, 150, 31, data_slot_color, UI_distance_units::pixels));
+
+    auto macro_27_bg = UI_crt_btn(UI_crt_rec(322, 91+39+39+39+39+39+39+39, 154, 35, test_slot_border_color, UI_distance_units::pixels), [](){ config_characterize_drive(); });
+        macro_27_bg->set_states(UI_crt_rec(322, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(322, 91+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_27 = UI_crt_txtbox("Characterize", text_alignment, UI_crt_rec(324, 93+39+39+39+39+39+39+39, 150, 31, test_slot_color, UI_distance_units::pixels));
+
+    auto macro_28_bg = UI_crt_btn(UI_crt_rec(4, 91+39+39+39+39+39+39+39+39, 154, 35, macro_slot_border_color, UI_distance_units::pixels), [](){ config_record_odom_log(); });
+    macro_28_bg->set_states(UI_crt_rec(4, 91+39+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels), UI_crt_rec(4, 91+39+39+39+39+39+39+39+39, 154, 35, 0x00B6B6B6, UI_distance_units::pixels));
+    auto macro_28 = UI_crt_txtbox("Record Odom", text_alignment, UI_crt_rec(6, 93+39+39+39+39+39+39+39+39, 150, 31, macro_slot_color, UI_distance_units::pixels));
+
     UI_config_scr->add_UI_components({bg, 
         macro_1_bg, macro_1, macro_2_bg, macro_2, macro_3_bg, macro_3,
         macro_4_bg, macro_4_bg_tgl, macro_4, macro_5_bg, macro_5, macro_6_bg, macro_6,
@@ -121,6 +161,10 @@ void UI_config_screen::UI_crt_config_scr() {
         macro_10_bg, macro_10_bg_tgl, macro_10, macro_11_bg, macro_11, macro_12_bg, macro_12,
         macro_13_bg, macro_13, macro_14_bg, macro_14, macro_15_bg, macro_15,
         macro_16_bg, macro_16, macro_17_bg, macro_17, macro_18_bg, macro_18,
+        macro_19_bg, macro_19, macro_20_bg, macro_20, macro_21_bg, macro_21,
+        macro_22_bg, macro_22, macro_23_bg, macro_23, macro_24_bg, macro_24,
+        macro_25_bg, macro_25, macro_26_bg, macro_26, macro_27_bg, macro_27,
+        macro_28_bg, macro_28,
     });
 
     for (const auto& component : UI_config_scr->get_UI_components()) {
@@ -25,6 +25,16 @@ void default_constants(void) {
   chassis.set_drive_exit_conditions(1, 75, 3000);
   chassis.set_swing_exit_conditions(1.25, 75, 3000);
 
+  chassis.set_turn_early_settle_conditions(15, 20);
+  chassis.set_drive_early_settle_conditions(3, 20);
+  chassis.set_swing_early_settle_conditions(15, 20);
+
+  chassis.set_drive_profile_constants(60, 120, 0);
+  chassis.set_turn_profile_constants(450, 1500, 0);
+  chassis.set_drive_feedforward_constants(0, .17, .02, 0);
+  chassis.load_drive_feedforward_constants(); // Replaces the line above with config_characterize_drive() results when they're on the SD card.
+  chassis.set_turn_feedforward_constants(0, .02, .002, 0);
+
   assembly.set_LB_constants(12, .2, .1, .02, 0, .5, 200, 3000);
 }
 
@@ -44,56 +44,28 @@ void user_control(void) {
   }
 }
 
-std::vector<point> path = {
+// Paths are written as the waypoints the robot passes through and sampled into evenly spaced points at compile time.
+constexpr point path_waypoints[] = {
     {  0.000,   0.000 },
-    { -0.149,   1.994 },
-    { -0.225,   3.993 },
     { -0.220,   5.992 },
-    { -0.100,   7.988 },
-    {  0.134,   9.974 },
-    {  0.515,  11.937 },
-    {  1.071,  13.857 },
-    {  1.825,  15.708 },
     {  2.800,  17.452 },
-    {  4.018,  19.036 },
-    {  5.462,  20.416 },
-    {  7.097,  21.564 },
-    {  8.884,  22.459 },
     { 10.769,  23.123 },
-    { 12.714,  23.582 },
-    { 14.693,  23.867 },
-    { 16.688,  24.004 },
     { 18.688,  24.018 },
-    { 20.686,  23.931 },
-    { 22.678,  23.760 },
-    { 23.554,  23.664 },
     { 23.554,  23.664 },
 };
+constexpr auto path = catmull_rom_path<24>(path_waypoints);
 
-std::vector<point> path_2 = {
+constexpr point path_2_waypoints[] = {
     {  0.000,   0.000 },
-    { -0.098,   1.997 },
-    { -0.004,   3.993 },
     {  0.419,   5.944 },
-    {  1.314,   7.722 },
-    {  2.789,   9.053 },
     {  4.622,   9.831 },
-    {  6.588,  10.189 },
-    {  8.582,  10.324 },
     { 10.582,  10.364 },
-    { 12.582,  10.406 },
-    { 14.576,  10.542 },
     { 16.547,  10.871 },
-    { 18.439,  11.506 },
-    { 20.138,  12.549 },
     { 21.491,  14.014 },
-    { 22.444,  15.768 },
-    { 23.037,  17.676 },
     { 23.393,  19.643 },
-    { 23.536,  21.637 },
-    { 23.554,  23.664 },
     { 23.554,  23.664 },
 };
+constexpr auto path_2 = catmull_rom_path<24>(path_2_waypoints);
 
 
 int main() {
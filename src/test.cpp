@@ -23,11 +23,11 @@ void test_heading() {
 }
 
 void test_turn() {
-  chassis.turn_to_angle(5, {.min_voltage = 5, .settle_time = 0, .settle_error = 3});
-  chassis.turn_to_angle(30, {.min_voltage = 5, .settle_time = 0, .settle_error = 3});
-  chassis.turn_to_angle(90, {.min_voltage = 5, .settle_time = 0, .settle_error = 3});
-  chassis.turn_to_angle(225, {.min_voltage = 5, .settle_time = 0, .settle_error = 3});
-  chassis.turn_to_angle(360, {.min_voltage = 5, .settle_time = 0, .settle_error = 3});
+  chassis.turn_to_angle(5, {.min_voltage = 5, .settle_error = 3, .settle_time = 0});
+  chassis.turn_to_angle(30, {.min_voltage = 5, .settle_error = 3, .settle_time = 0});
+  chassis.turn_to_angle(90, {.min_voltage = 5, .settle_error = 3, .settle_time = 0});
+  chassis.turn_to_angle(225, {.min_voltage = 5, .settle_error = 3, .settle_time = 0});
+  chassis.turn_to_angle(360, {.min_voltage = 5, .settle_error = 3, .settle_time = 0});
 }
 
 void test_swing() {
@@ -344,7 +344,7 @@ void PID_tuner() {
       }
       if (Controller.ButtonB.pressing()) {
         user_control_task.resume();
-        test_movements_task.stop();
+        chassis.stop_motion_task(test_movements_task);
         chassis.stop_drive(vex::coast);
         task::sleep(200);
       }
@@ -567,3 +567,469 @@ void config_test_three_wire_port(port port) {
   vex::digital_out dig_out = Brain.ThreeWirePort.Port[port];
   dig_out.set(!dig_out.value());
 }
+
+void config_benchmark_lookahead() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+
+  vex::task benchmark([](){
+    task::sleep(500);
+    const float lookahead_distance = 12;
+
+    for (int path_size : {100, 400, 800}) {
+      std::vector<point> path = {};
+      for (int k = 0; k < path_size; k++) {
+        path.push_back({ 24 * sin(k * 0.05), k * 0.5 });
+      }
+
+      // The robot sits an inch off the path at every waypoint, like it would while following it.
+      std::vector<point> positions = {};
+      for (const point& waypoint : path) {
+        positions.push_back({ waypoint.x + 1, waypoint.y });
+      }
+
+      uint64_t start = vex::timer::systemHighResolution();
+      size_t i = 0;
+      point old_target = path[0];
+      int old_ticks = 0;
+      for (const point& position : positions) {
+        old_ticks++;
+        while (i < path.size() - 1 && dist(position, path[i+1]) <= lookahead_distance) {
+          i++;
+        }
+        if (i >= path.size() - 1) { break; }
+        std::vector<point> intersections = line_circle_intersections(position, lookahead_distance, path[i], path[i+1]);
+        if (intersections.size() == 2) {
+          old_target = dist(intersections[0], path[i+1]) < dist(intersections[1], path[i+1]) ? intersections[0] : intersections[1];
+        } else if (intersections.size() == 1) {
+          old_target = intersections[0];
+        }
+      }
+      float old_us = (float)(vex::timer::systemHighResolution() - start) / old_ticks;
+
+      start = vex::timer::systemHighResolution();
+      pursuit_lookahead lookahead;
+      point new_target = path[0];
+      int new_ticks = 0;
+      for (const point& position : positions) {
+        new_ticks++;
+        lookahead.find(path, position, lookahead_distance, new_target);
+        if (lookahead.is_finished(path, position, lookahead_distance)) { break; }
+      }
+      float new_us = (float)(vex::timer::systemHighResolution() - start) / new_ticks;
+
+      console_scr->add(std::to_string(path_size) + " pts old: " + to_string_float(old_us, 2) + "us/tick, new: " + to_string_float(new_us, 2) + "us/tick", false);
+      console_scr->add("  final target diff: " + to_string_float(dist(old_target, new_target), 3) + "in", false);
+    }
+    return 0;
+  });
+}
+
+void config_characterize_drive() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task characterize([](){
+    task::sleep(500);
+    chassis.cancel_motion();
+    console_scr->add("Characterizing drive...", false);
+
+    struct characterization_test {
+      float start_voltage; // Volts applied right away, for the dynamic steps.
+      float ramp_rate; // Volts added per second, for the quasistatic ramps.
+      float direction;
+    };
+    const characterization_test tests[] = { {0, 1, 1}, {0, 1, -1}, {7, 0, 1}, {7, 0, -1} };
+    const float max_distance = 40;
+    const float max_voltage = 10;
+    const float dt = .01;
+
+    std::vector<feedforward_sample> samples = {};
+    samples.reserve(4000);
+
+    for (const characterization_test& test : tests) {
+      size_t first_sample = samples.size();
+      float start_position = chassis.get_ForwardTracker_position();
+      float time = 0;
+      uint32_t next_tick = vex::timer::system();
+
+      while (1) {
+        float voltage = test.direction * (test.start_voltage + test.ramp_rate * time);
+        if (fabs(voltage) > max_voltage || fabs(chassis.get_ForwardTracker_position() - start_position) > max_distance) { break; }
+        chassis.drive_with_voltage(voltage, voltage);
+
+        next_tick += dt * 1000;
+        vex::this_thread::sleep_until(next_tick);
+        time += dt;
+
+        float measured_voltage = (chassis.left_drive.averageVoltage(vex::volt) + chassis.right_drive.averageVoltage(vex::volt)) / 2;
+        float velocity = (chassis.get_left_velocity() + chassis.get_right_velocity()) / 2;
+        samples.push_back({ measured_voltage, velocity, 0 });
+      }
+      chassis.stop_drive(vex::brake);
+
+      // The last sample of each run has no next velocity to compare against.
+      for (size_t i = first_sample; i + 1 < samples.size(); i++) {
+        samples[i].acceleration = (samples[i+1].velocity - samples[i].velocity) / dt;
+      }
+      if (samples.size() > first_sample) { samples.pop_back(); }
+
+      task::sleep(1000);
+    }
+
+    feedforward measured = chassis.drive_feedforward;
+    float r_squared = fit_feedforward(samples, 1, dt, measured);
+    if (r_squared < 0) {
+      console_scr->add("Not enough data, is the drive plugged in?", false);
+      disable_user_control = false;
+      return 0;
+    }
+    chassis.drive_feedforward = measured;
+
+    console_scr->add("ks: " + to_string_float(measured.ks, 4), false);
+    console_scr->add("kv: " + to_string_float(measured.kv, 4), false);
+    console_scr->add("ka: " + to_string_float(measured.ka, 4), false);
+    console_scr->add("r^2: " + to_string_float(r_squared, 4) + " from " + std::to_string(samples.size()) + " samples", false);
+
+    if (Brain.SDcard.isInserted()) {
+      std::string output = "\nks: " + to_string_float(measured.ks, 5) + "\nkv: " + to_string_float(measured.kv, 5) + "\nka: " + to_string_float(measured.ka, 5);
+      std::vector<uint8_t> buffer(output.begin(), output.end());
+      Brain.SDcard.savefile("drive_feedforward.txt", buffer.data(), buffer.size());
+      console_scr->add("Saved to drive_feedforward.txt", false);
+    }
+
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+void config_replay_odom_log() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task replay([](){
+    task::sleep(500);
+    if (!Brain.SDcard.isInserted()) {
+      console_scr->add("No SD card inserted", false);
+      disable_user_control = false;
+      return 0;
+    }
+
+    if (!SD_text_file_exists("odom_log.txt")) {
+      console_scr->add("No log recorded, record one with Record Odom", false);
+      disable_user_control = false;
+      return 0;
+    }
+
+    pose arc, ekf, mcl, start;
+    if (!chassis.replay_odom_log("odom_log.txt", arc, ekf, mcl, start)) {
+      console_scr->add("Couldn't read odom_log.txt", false);
+      disable_user_control = false;
+      return 0;
+    }
+
+    console_scr->add("Replayed " + std::to_string(arc.seq) + " samples", false);
+    console_scr->add("Arc: " + to_string_float(arc.x, 2) + ", " + to_string_float(arc.y, 2) + ", " + to_string_float(arc.theta, 1), false);
+    console_scr->add("  error from start: " + to_string_float(hypot(arc.x - start.x, arc.y - start.y), 2) + "in", false);
+    console_scr->add("EKF: " + to_string_float(ekf.x, 2) + ", " + to_string_float(ekf.y, 2) + ", " + to_string_float(ekf.theta, 1), false);
+    console_scr->add("  error from start: " + to_string_float(hypot(ekf.x - start.x, ekf.y - start.y), 2) + "in", false);
+    console_scr->add("Arc + walls: " + to_string_float(mcl.x, 2) + ", " + to_string_float(mcl.y, 2) + ", " + to_string_float(mcl.theta, 1), false);
+    console_scr->add("  error from start: " + to_string_float(hypot(mcl.x - start.x, mcl.y - start.y), 2) + "in", false);
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+void config_record_odom_log() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task record([](){
+    task::sleep(500);
+    if (!Brain.SDcard.isInserted()) {
+      console_scr->add("No SD card inserted", false);
+      disable_user_control = false;
+      return 0;
+    }
+
+    // test_odom_full() ends where it starts, so the replayed final pose is the error.
+    console_scr->add("Recording test_odom_full()...", false);
+    odom_constants();
+    chassis.set_coordinates(0, 0, 0);
+    chassis.start_odom_log();
+    test_odom_full();
+    chassis.save_odom_log("odom_log.txt");
+    console_scr->add("Saved odom_log.txt", false);
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+void config_settle_report() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task report([](){
+    task::sleep(500);
+    // The early settle conditions are put back afterwards, so the report doesn't change later motions.
+    const float drive_settle_velocity = chassis.drive_settle_velocity, drive_settle_confirm_time = chassis.drive_settle_confirm_time;
+    const float turn_settle_velocity = chassis.turn_settle_velocity, turn_settle_confirm_time = chassis.turn_settle_confirm_time;
+    const float swing_settle_velocity = chassis.swing_settle_velocity, swing_settle_confirm_time = chassis.swing_settle_confirm_time;
+    default_constants();
+    // Early settling may have been turned off, so fall back to a conservative setting for the report.
+    if (chassis.drive_settle_velocity == 0) { chassis.set_drive_early_settle_conditions(2, 30); }
+    if (chassis.turn_settle_velocity == 0) { chassis.set_turn_early_settle_conditions(10, 30); }
+    if (chassis.swing_settle_velocity == 0) { chassis.set_swing_early_settle_conditions(10, 30); }
+    console_scr->add("Running test_full() with early settling...", false);
+
+    chassis.set_coordinates(0, 0, 0);
+    chassis.start_settle_report();
+    test_full();
+    std::vector<settle_report_entry> entries = chassis.get_settle_report();
+
+    float total_duration = 0, total_saved = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+      console_scr->add("motion " + to_string(i + 1) + ": " + to_string(entries[i].duration) + "ms, saved " + to_string_float(entries[i].time_saved, 0) + "ms", false);
+      total_duration += entries[i].duration;
+      total_saved += entries[i].time_saved;
+    }
+    console_scr->add("total: " + to_string_float(total_duration, 0) + "ms, saved " + to_string_float(total_saved, 0) + "ms", false);
+    chassis.set_drive_early_settle_conditions(drive_settle_velocity, drive_settle_confirm_time);
+    chassis.set_turn_early_settle_conditions(turn_settle_velocity, turn_settle_confirm_time);
+    chassis.set_swing_early_settle_conditions(swing_settle_velocity, swing_settle_confirm_time);
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+/**
+ * @brief Drives out and back, watching the drive current and how far the drive encoders
+ * get ahead of the forward tracker, which is how much the wheels spun out.
+ */
+static void measure_slew_run(float accelerate, float decelerate, float& peak_current, float& slip) {
+  peak_current = 0;
+  slip = 0;
+  for (float distance : {24.0f, -24.0f}) {
+    odom_sample start = chassis.get_odom_sample();
+    chassis.drive_distance(distance, { .wait = false, .slew_accelerate = accelerate, .slew_decelerate = decelerate });
+    task::sleep(20);
+    while (chassis.is_in_motion()) {
+      sensor_frame frame = chassis.get_frame();
+      peak_current = std::max(peak_current, std::max(frame.left_current, frame.right_current));
+      task::sleep(10);
+    }
+    odom_sample end = chassis.get_odom_sample();
+    float drive_travel = ((end.left_drive - start.left_drive) + (end.right_drive - start.right_drive)) / 2;
+    slip += fabs(drive_travel - (end.forward_tracker - start.forward_tracker));
+  }
+}
+
+void config_compare_slew() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task compare([](){
+    task::sleep(500);
+    default_constants();
+    // Use the tuned slew when there is one, otherwise a moderate 0 to 12 volts in a quarter second.
+    float accelerate = chassis.drive_slew_accelerate > 0 ? chassis.drive_slew_accelerate : 48;
+    float decelerate = chassis.drive_slew_decelerate > 0 ? chassis.drive_slew_decelerate : 96;
+
+    float peak_current, slip;
+    console_scr->add("Driving 24in out and back without slew...", false);
+    measure_slew_run(0, 0, peak_current, slip);
+    console_scr->add("  peak current " + to_string_float(peak_current, 2) + "A, slip " + to_string_float(slip, 2) + "in", false);
+    task::sleep(500);
+
+    console_scr->add("With slew " + to_string_float(accelerate, 0) + "/" + to_string_float(decelerate, 0) + " V/s...", false);
+    measure_slew_run(accelerate, decelerate, peak_current, slip);
+    console_scr->add("  peak current " + to_string_float(peak_current, 2) + "A, slip " + to_string_float(slip, 2) + "in", false);
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+void config_test_motion_queue() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+  disable_user_control = true;
+
+  vex::task queue([](){
+    task::sleep(500);
+    console_scr->add("Running test_odom_full() as a queue...", false);
+    motion_chaining_constants();
+    chassis.set_coordinates(0, 0, 0);
+    uint32_t start = vex::timer::system();
+
+    // The same route as test_odom_full(), blending through the middle at 20in/s and 180deg/s.
+    chassis.queue_drive_to_point(0, 24, {}, 20);
+    chassis.queue_motion("turn_to_point", [](){ chassis.turn_to_point(26.833, 0, { .angle_offset = 180, .wait = false }); });
+    chassis.queue_drive_to_point(26.833, 0, {}, 20);
+    chassis.queue_motion("turn_to_point", [](){ chassis.turn_to_point(0, 0, { .wait = false }); });
+    chassis.queue_drive_to_point(0, 0, {}, 20);
+    chassis.queue_turn_to_angle(0, { .min_voltage = 0, .settle_error = 1, .settle_time = 75 });
+    chassis.wait_for_queue();
+    chassis.stop_drive(hold);
+
+    for (const motion_segment_timing& timing : chassis.get_segment_timings()) {
+      console_scr->add(timing.name + ": " + to_string(timing.end_time - timing.start_time) + "ms", false);
+    }
+    console_scr->add("total: " + to_string(vex::timer::system() - start) + "ms", false);
+    disable_user_control = false;
+    return 0;
+  });
+}
+
+/** @brief Tracker and heading readings along a synthetic run, with the true end position. */
+struct synthetic_odom_run {
+  std::vector<double> forward; // Forward tracker position in inches.
+  std::vector<double> sideways; // Sideways tracker position in inches.
+  std::vector<double> heading; // Degrees, 0-360.
+  double x = 0;
+  double y = 0;
+};
+
+/**
+ * @brief Weaves at 200Hz. Speed and turn rate are held for each 5 ms update, so the robot
+ * drives exact arcs and any error left in odometry comes from the math, not the model.
+ * @param base_velocity Added to a +-40 in/s swing, above 40 the robot never reverses so the trackers keep counting up.
+ */
+static synthetic_odom_run generate_synthetic_odom_run(int updates, float base_velocity, float forward_center_distance, float sideways_center_distance) {
+  synthetic_odom_run run;
+  run.forward.resize(updates);
+  run.sideways.resize(updates);
+  run.heading.resize(updates);
+  double theta = 0, forward_position = 0, sideways_position = 0;
+  for (int i = 0; i < updates; i++) {
+    double t = i * .005;
+    double distance = (base_velocity + 40 * sin(.3 * t)) * .005;
+    double turn = 120 * sin(.5 * t) * M_PI / 180 * .005;
+    double chord_ratio = fabs(turn) > 1e-9 ? 2 * sin(turn / 2) / turn : 1;
+    double mid = theta + turn / 2;
+    run.x += distance * chord_ratio * sin(mid);
+    run.y += distance * chord_ratio * cos(mid);
+    theta += turn;
+    forward_position += distance - forward_center_distance * turn;
+    sideways_position += -sideways_center_distance * turn;
+    run.forward[i] = forward_position;
+    run.sideways[i] = sideways_position;
+    run.heading[i] = fmod(fmod(theta * 180 / M_PI, 360) + 360, 360);
+  }
+  return run;
+}
+
+void config_benchmark_odom() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+
+  vex::task benchmark([](){
+    task::sleep(500);
+    console_scr->add("Benchmarking odom on a 60s synthetic run...", false);
+
+    const int updates = 12000;
+    const float forward_center_distance = 1.5;
+    const float sideways_center_distance = -2.5;
+    synthetic_odom_run run = generate_synthetic_odom_run(updates, 0, forward_center_distance, sideways_center_distance);
+    std::vector<float> forward(run.forward.begin(), run.forward.end());
+    std::vector<float> sideways(run.sideways.begin(), run.sideways.end());
+    std::vector<float> heading(run.heading.begin(), run.heading.end());
+    double x = run.x, y = run.y;
+
+    odom fast, polar;
+    fast.set_physical_distances(forward_center_distance, sideways_center_distance);
+    polar.set_physical_distances(forward_center_distance, sideways_center_distance);
+    fast.set_position({0, 0}, 0, 0, 0);
+    polar.set_position({0, 0}, 0, 0, 0);
+
+    float max_divergence = 0;
+    uint64_t fast_time = 0, polar_time = 0;
+    for (int i = 0; i < updates; i++) {
+      uint64_t start = vex::timer::systemHighResolution();
+      fast.update_position(forward[i], sideways[i], heading[i]);
+      uint64_t middle = vex::timer::systemHighResolution();
+      polar.update_position_polar(forward[i], sideways[i], heading[i]);
+      polar_time += vex::timer::systemHighResolution() - middle;
+      fast_time += middle - start;
+      max_divergence = std::max(max_divergence, dist(fast.position, polar.position));
+    }
+
+    console_scr->add("polar: " + to_string_float((float)polar_time / updates, 3) + "us/update, error " + to_string_float(hypot(polar.position.x - x, polar.position.y - y), 4) + "in", false);
+    console_scr->add("fast: " + to_string_float((float)fast_time / updates, 3) + "us/update, error " + to_string_float(hypot(fast.position.x - x, fast.position.y - y), 4) + "in", false);
+    console_scr->add("max difference during run: " + to_string_float(max_divergence, 4) + "in", false);
+    return 0;
+  });
+}
+
+void config_benchmark_odom_precision() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+
+  vex::task benchmark([](){
+    task::sleep(500);
+    console_scr->add("Comparing odom precision on a 60s synthetic run...", false);
+
+    // Always driving forwards, so the tracker totals grow into the thousands of inches like a skills run.
+    const int updates = 12000;
+    const float forward_center_distance = 1.5;
+    const float sideways_center_distance = -2.5;
+    const double inch_per_tick = M_PI * 2 / 36000; // 2 inch wheel read in hundredths of a degree.
+    synthetic_odom_run run = generate_synthetic_odom_run(updates, 45, forward_center_distance, sideways_center_distance);
+
+    odom standard, precise;
+    standard.set_physical_distances(forward_center_distance, sideways_center_distance);
+    precise.set_physical_distances(forward_center_distance, sideways_center_distance);
+    standard.set_position({0, 0}, 0, 0, 0);
+    precise.set_position_ticks({0, 0}, 0, 0, 0, inch_per_tick, inch_per_tick);
+
+    for (int i = 0; i < updates; i++) {
+      // Both modes see the same whole encoder ticks, the standard mode converts them to float inches like get_ForwardTracker_position().
+      int32_t forward_ticks = lround(run.forward[i] / inch_per_tick);
+      int32_t sideways_ticks = lround(run.sideways[i] / inch_per_tick);
+      standard.update_position(forward_ticks * inch_per_tick, sideways_ticks * inch_per_tick, run.heading[i]);
+      precise.update_position_ticks(forward_ticks, sideways_ticks, run.heading[i]);
+    }
+
+    console_scr->add("distance driven: " + to_string_float(run.forward.back(), 1) + "in", false);
+    console_scr->add("float drift: " + to_string_float(hypot(standard.position.x - run.x, standard.position.y - run.y), 5) + "in", false);
+    console_scr->add("precision drift: " + to_string_float(hypot(precise.position.x - run.x, precise.position.y - run.y), 5) + "in", false);
+    return 0;
+  });
+}
+
+// The loop based reduction util.cpp used before it was made constant time, kept to time against.
+static float reduce_negative_180_to_180_loop(float angle) {
+  while(!(angle >= -180 && angle < 180)) {
+    if(angle < -180) { angle += 360; }
+    if(angle >= 180) { angle -= 360; }
+  }
+  return angle;
+}
+
+void config_benchmark_angles() {
+  console_scr->reset();
+  UI_select_scr(console_scr->get_console_screen());
+
+  vex::task benchmark([](){
+    task::sleep(500);
+    // Headings straight from inertial.rotation() drift several turns from 0 over a match,
+    // which is where the loop slows down.
+    const int calls = 10000;
+    volatile float sink = 0;
+    for (float turns : {0.5f, 5.0f, 50.0f}) {
+      float angle = turns * 360 + 17;
+      uint64_t start = vex::timer::systemHighResolution();
+      for (int i = 0; i < calls; i++) { sink = reduce_negative_180_to_180_loop(angle + i * 1e-3f); }
+      uint64_t middle = vex::timer::systemHighResolution();
+      for (int i = 0; i < calls; i++) { sink = reduce_negative_180_to_180(angle + i * 1e-3f); }
+      uint64_t end = vex::timer::systemHighResolution();
+      console_scr->add(to_string_float(turns, 1) + " turns: loop " + to_string_float((float)(middle - start) * 1000 / calls, 1) + "ns, constant " + to_string_float((float)(end - middle) * 1000 / calls, 1) + "ns", false);
+    }
+    (void)sink;
+    return 0;
+  });
+}